@@ -0,0 +1,63 @@
+// 最終アクセス時刻の更新: アトミック時刻と mutex の比較
+#include "chrono_atomic.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#define COUNT (1 << 20)
+
+static chrono_mno_atomic_t atomic_last;
+static chrono_mno_t mutex_last;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static chrono_mno_pack_t base;
+
+static void * atomicWorker(void * arg)
+{
+    intptr_t id = (intptr_t)arg;
+    for (int i = 0; i < COUNT; ++i) {
+        chrono_mno_pack_t p = { base.value + i * 16 + id };
+        ChronoMnoAtomicFetchMaxPack(&atomic_last, &p, NULL);
+    }
+    return NULL;
+}
+
+static void * mutexWorker(void * arg)
+{
+    intptr_t id = (intptr_t)arg;
+    for (int i = 0; i < COUNT; ++i) {
+        chrono_mno_pack_t p = { base.value + i * 16 + id };
+        chrono_mno_t cm;
+        ChronoMnoUnpack(&p, &cm);
+        pthread_mutex_lock(&mutex);
+        if (ChronoMnoComp(&mutex_last, &cm) < 0)
+            mutex_last = cm;
+        pthread_mutex_unlock(&mutex);
+    }
+    return NULL;
+}
+
+static double run(int threads, void * (*worker)(void *))
+{
+    pthread_t th[16];
+    chrono_mno_t start;
+    chrono_t c;
+
+    // 前回の実行で最大値まで進んだままだと比較だけで終わるので、毎回初期化する
+    ChronoMnoPackNow(&base);
+    ChronoMnoAtomicInitPack(&atomic_last, &base);
+    ChronoMnoUnpack(&base, &mutex_last);
+
+    ChronoMnoNow(&start);
+    for (intptr_t i = 0; i < threads; ++i)
+        pthread_create(&th[i], NULL, worker, (void *)i);
+    for (int i = 0; i < threads; ++i)
+        pthread_join(th[i], NULL);
+    ChronoMnoDiffNow(&start, &c);
+    return (double)ChronoGet(&c, chrono_nanoseconds) / ((double)COUNT * threads);
+}
+
+int main()
+{
+    printf("%-8s %12s %12s\n", "threads", "atomic", "mutex");
+    for (int t = 1; t <= 16; t *= 2)
+        printf("%-8d %9.2f ns %9.2f ns\n", t, run(t, atomicWorker), run(t, mutexWorker));
+}
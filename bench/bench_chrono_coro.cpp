@@ -0,0 +1,44 @@
+// 100万個のコルーチンが同時に sleep する
+#include "chrono_coro.hpp"
+#include <cstdio>
+#include <sys/resource.h>
+
+static const int N = 1000000;
+static const int SPAN_MS = 1000;
+
+static long maxrss()
+{
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+static Chrono::task sleeper(Chrono::executor & ex, Chrono::microseconds d, int & done)
+{
+    co_await ex.sleep_for(d);
+    ++done;
+}
+
+int main()
+{
+    Chrono::executor ex;
+    int done = 0;
+    std::uint64_t seed = 1;
+    long rss0 = maxrss();
+
+    Chrono::mno_time start = Chrono::mno_time::now();
+    for (int i = 0; i < N; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        ex.spawn(sleeper(ex, Chrono::microseconds(static_cast<std::int64_t>((seed >> 33) % (SPAN_MS * 1000))), done));
+    }
+    Chrono::mno_time spawned = Chrono::mno_time::now();
+    ex.run();
+    Chrono::mno_time finished = Chrono::mno_time::now();
+    long rss1 = maxrss();
+
+    std::printf("tasks        %d (completed %d)\n", N, done);
+    std::printf("spawn        %.1f ns/task\n", static_cast<double>((spawned - start).count()) / N);
+    std::printf("run          %.3f s (sleeps up to %d ms)\n", static_cast<double>((finished - spawned).count()) / 1e9, SPAN_MS);
+    std::printf("wakeups      %ju\n", static_cast<std::uintmax_t>(ex.wakeups()));
+    std::printf("memory       %.0f bytes/task (maxrss %ld KB)\n", (rss1 - rss0) * 1024.0 / N, rss1);
+}
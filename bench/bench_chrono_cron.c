@@ -0,0 +1,35 @@
+// cron 式の次の発火時刻を 100 万回求める
+#include "chrono_mno.h"
+#include "chrono_cron.h"
+#include <stdio.h>
+
+#define COUNT 1000000
+
+int main()
+{
+    static char const * const exprs[] = {
+        "* * * * *", "*/15 9-17 * * MON-FRI", "0 0 1 * *", "30 2 * * SUN", "0 0 29 2 *", "0 0 13 * 5",
+    };
+    chrono_sys_t base;
+    ChronoSysNow(&base);
+
+    for (size_t i = 0; i < sizeof(exprs) / sizeof(exprs[0]); ++i) {
+        chrono_cron_t cron;
+        chrono_sys_t t, n;
+        chrono_mno_t start;
+        chrono_t c;
+        uint64_t seed = 1, sum = 0;
+        ChronoCronParse(&cron, exprs[i]);
+
+        ChronoMnoNow(&start);
+        for (int k = 0; k < COUNT; ++k) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            t = base;
+            t.time_point.tv_sec += (time_t)((seed >> 33) % (10 * 365 * 86400));
+            ChronoCronNext(&cron, &t, &n);
+            sum += n.time_point.tv_sec;
+        }
+        ChronoMnoDiffNow(&start, &c);
+        printf("%-24s %6.1f ns/next (%ju)\n", exprs[i], (double)ChronoGet(&c, chrono_nanoseconds) / COUNT, (uintmax_t)(sum & 0xff));
+    }
+}
@@ -0,0 +1,56 @@
+// 期間の文字列化: ChronoFormat と snprintf の比較
+#include "chrono_format.h"
+#include "chrono_mno.h"
+#include <stdio.h>
+
+#define COUNT 1000000
+
+static double elapsed(chrono_mno_t const * start)
+{
+    chrono_t c;
+    ChronoMnoDiffNow(start, &c);
+    return (double)ChronoGet(&c, chrono_nanoseconds) / COUNT;
+}
+
+/*!
+  ChronoGet の結果を snprintf で ChronoFormat と同じ形にする (小数部は 3 桁固定).
+ */
+static int snprintfFormat(chrono_t const * c, char * buf, size_t size)
+{
+    intmax_t ns = ChronoGet(c, chrono_nanoseconds);
+    if (ns >= 60000000000)
+        return snprintf(buf, size, "%jdh%02jdm%02jd.%03jds", ns / 3600000000000, ns / 60000000000 % 60,
+                        ns / 1000000000 % 60, ns / 1000000 % 1000);
+    if (ns >= 1000000000)
+        return snprintf(buf, size, "%jd.%03jds", ns / 1000000000, ns / 1000000 % 1000);
+    if (ns >= 1000000)
+        return snprintf(buf, size, "%jd.%03jdms", ns / 1000000, ns / 1000 % 1000);
+    if (ns >= 1000)
+        return snprintf(buf, size, "%jd.%03jd\xc2\xb5s", ns / 1000, ns % 1000);
+    return snprintf(buf, size, "%jdns", ns);
+}
+
+int main()
+{
+    static chrono_t values[1024];
+    char buf[CHRONO_FORMAT_MAX];
+    uint64_t seed = 1, sum = 0;
+    for (int i = 0; i < 1024; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        // ナノ秒から数時間まで、桁数がばらつくようにする
+        values[i] = ChronoInit((intmax_t)((seed >> 20) >> (seed % 32)), chrono_nanoseconds);
+    }
+
+    chrono_mno_t start;
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i)
+        sum += ChronoFormat(&values[i & 1023], buf, sizeof(buf), 3) + (unsigned char)buf[0];
+    double format = elapsed(&start);
+
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i)
+        sum += (size_t)snprintfFormat(&values[i & 1023], buf, sizeof(buf)) + (unsigned char)buf[0];
+    double print = elapsed(&start);
+
+    printf("ChronoFormat: %6.1f ns/call\nsnprintf:     %6.1f ns/call\n(%ju)\n", format, print, (uintmax_t)sum);
+}
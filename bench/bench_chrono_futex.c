@@ -0,0 +1,127 @@
+// futex 待機と pthread の比較
+#include "chrono_futex.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+
+#define COUNT 100000
+
+static double elapsed(chrono_mno_t const * start, int n)
+{
+    chrono_t c;
+    ChronoMnoDiffNow(start, &c);
+    return (double)ChronoGet(&c, chrono_nanoseconds) / n;
+}
+
+/* 2 スレッド間のピンポン */
+
+static chrono_sem_t ping, pong;
+static sem_t pping, ppong;
+
+static void * chronoPong(void * arg)
+{
+    (void)arg;
+    for (int i = 0; i < COUNT; ++i) {
+        ChronoSemWait(&ping, NULL);
+        ChronoSemPost(&pong);
+    }
+    return NULL;
+}
+
+static void * posixPong(void * arg)
+{
+    (void)arg;
+    for (int i = 0; i < COUNT; ++i) {
+        sem_wait(&pping);
+        sem_post(&ppong);
+    }
+    return NULL;
+}
+
+/* イベント: pthread_cond + mutex 版 */
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool set;
+} cond_event_t;
+
+static bool condEventWait(cond_event_t * ev, struct timespec const * ts)
+{
+    pthread_mutex_lock(&ev->mutex);
+    int r = 0;
+    while (!ev->set && r == 0)
+        r = pthread_cond_timedwait(&ev->cond, &ev->mutex, ts);
+    bool set = ev->set;
+    pthread_mutex_unlock(&ev->mutex);
+    return set;
+}
+
+int main()
+{
+    chrono_mno_t start;
+    pthread_t th;
+
+    // 競合なしの post + wait
+    chrono_sem_t s;
+    sem_t ps;
+    ChronoSemInit(&s, 0);
+    sem_init(&ps, 0, 0);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i) {
+        ChronoSemPost(&s);
+        ChronoSemWait(&s, NULL);
+    }
+    double chrono_sem = elapsed(&start, COUNT);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i) {
+        sem_post(&ps);
+        sem_wait(&ps);
+    }
+    double posix_sem = elapsed(&start, COUNT);
+
+    // セット済みイベントの確認
+    chrono_event_t ev;
+    cond_event_t cev = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, true };
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += 1;
+    ChronoEventInit(&ev, true);
+    chrono_t timeout = ChronoInit(1, chrono_seconds);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i)
+        ChronoEventWaitFor(&ev, &timeout);
+    double chrono_event = elapsed(&start, COUNT);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i)
+        condEventWait(&cev, &ts);
+    double cond_event = elapsed(&start, COUNT);
+
+    // ピンポン
+    ChronoSemInit(&ping, 0);
+    ChronoSemInit(&pong, 0);
+    pthread_create(&th, NULL, chronoPong, NULL);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i) {
+        ChronoSemPost(&ping);
+        ChronoSemWait(&pong, NULL);
+    }
+    double chrono_pingpong = elapsed(&start, COUNT);
+    pthread_join(th, NULL);
+
+    sem_init(&pping, 0, 0);
+    sem_init(&ppong, 0, 0);
+    pthread_create(&th, NULL, posixPong, NULL);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < COUNT; ++i) {
+        sem_post(&pping);
+        sem_wait(&ppong);
+    }
+    double posix_pingpong = elapsed(&start, COUNT);
+    pthread_join(th, NULL);
+
+    printf("%-28s %12s %12s\n", "", "chrono", "pthread");
+    printf("%-28s %9.1f ns %9.1f ns\n", "sem post+wait", chrono_sem, posix_sem);
+    printf("%-28s %9.1f ns %9.1f ns\n", "event wait (already set)", chrono_event, cond_event);
+    printf("%-28s %9.1f ns %9.1f ns\n", "sem ping-pong round trip", chrono_pingpong, posix_pingpong);
+}
@@ -0,0 +1,83 @@
+// C++ ラッパーと整数演算、C 関数の比較
+#include "chrono.hpp"
+#include <cstdio>
+#include <vector>
+
+static const std::size_t N = 1 << 20;
+static const int ROUNDS = 20;
+
+template <class F>
+static double measure(F f)
+{
+    double best = 1e300;
+    for (int r = 0; r < ROUNDS; ++r) {
+        chrono_mno_t start;
+        chrono_t c;
+        ChronoMnoNow(&start);
+        f();
+        ChronoMnoDiffNow(&start, &c);
+        double ns = static_cast<double>(ChronoGet(&c, chrono_nanoseconds)) / N;
+        if (ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int main()
+{
+    std::vector<std::int64_t> raw_a(N), raw_b(N);
+    std::vector<Chrono::mno_time> hpp_a(N), hpp_b(N);
+    std::vector<chrono_mno_t> c_a(N), c_b(N);
+
+    Chrono::mno_time base = Chrono::mno_time::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        hpp_a[i] = base + Chrono::nanoseconds(static_cast<std::int64_t>(i * 7919 % 1000003));
+        hpp_b[i] = hpp_a[i] + Chrono::microseconds(static_cast<std::int64_t>(i % 1000));
+        raw_a[i] = hpp_a[i].time_since_epoch().count();
+        raw_b[i] = hpp_b[i].time_since_epoch().count();
+        c_a[i] = hpp_a[i];
+        c_b[i] = hpp_b[i];
+    }
+
+    volatile std::int64_t sink = 0;
+
+    double raw = measure([&] {
+        std::int64_t sum = 0, late = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            std::int64_t d = raw_b[i] - raw_a[i];
+            sum += d / 1000;
+            late += (raw_b[i] > raw_a[i] + 500000);
+        }
+        sink = sum + late;
+    });
+
+    double hpp = measure([&] {
+        Chrono::microseconds sum(0);
+        std::int64_t late = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            sum += Chrono::duration_cast<Chrono::microseconds>(hpp_b[i] - hpp_a[i]);
+            late += (hpp_b[i] > hpp_a[i] + Chrono::microseconds(500));
+        }
+        sink = sum.count() + late;
+    });
+
+    double c = measure([&] {
+        std::int64_t sum = 0, late = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            chrono_t d;
+            chrono_mno_t deadline = c_a[i];
+            ChronoMnoDiff(&c_b[i], &c_a[i], &d);
+            sum += ChronoGet(&d, chrono_microseconds);
+            ChronoMnoAddValue(&deadline, 500, chrono_microseconds);
+            late += (ChronoMnoComp(&c_b[i], &deadline) > 0);
+        }
+        sink = sum + late;
+    });
+
+    (void)sink;
+    std::printf("diff + compare, %zu elements\n", N);
+    std::printf("  int64_t     : %6.2f ns/op\n", raw);
+    std::printf("  chrono.hpp  : %6.2f ns/op\n", hpp);
+    std::printf("  C functions : %6.2f ns/op\n", c);
+    return 0;
+}
@@ -0,0 +1,109 @@
+// 時刻索引と二分探索の比較: ほぼ等間隔の時刻列の下限検索
+#include "chrono_index.h"
+#include "chrono_mno.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define QUERIES 1000000
+
+static uint64_t rnd(uint64_t * seed)
+{
+    *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *seed >> 11;
+}
+
+static double elapsed(chrono_mno_t const * start)
+{
+    chrono_t c;
+    ChronoMnoDiffNow(start, &c);
+    return (double)ChronoGet(&c, chrono_nanoseconds);
+}
+
+static size_t sysLowerBound(chrono_sys_t const * a, size_t n, chrono_sys_t const * key)
+{
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (ChronoSysComp(&a[lo + half], key) < 0) {
+            lo += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+static size_t packLowerBound(chrono_sys_pack_t const * a, size_t n, chrono_sys_pack_t const * key)
+{
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (a[lo + half].value < key->value) {
+            lo += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+int main(int argc, char ** argv)
+{
+    size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : 10000000;
+    chrono_sys_pack_t * keys = malloc(n * sizeof(*keys));
+    chrono_sys_t * sys = malloc(n * sizeof(*sys));
+    chrono_sys_pack_t * q = malloc(QUERIES * sizeof(*q));
+    chrono_sys_t * qsys = malloc(QUERIES * sizeof(*qsys));
+    size_t * pos = malloc(QUERIES * sizeof(*pos));
+    chrono_sys_pack_t base = { 0 };
+    uint64_t seed = 1, sum;
+    ChronoSysPackNow(&base);
+
+    // 1 ミリ秒間隔に ±100 マイクロ秒の揺らぎ
+    for (size_t i = 0; i < n; ++i)
+        keys[i].value = base.value + (int64_t)i * 1000000 + (int64_t)(rnd(&seed) % 200000);
+    ChronoSysUnpackArray(keys, sys, n);
+    for (size_t i = 0; i < QUERIES; ++i)
+        q[i].value = base.value + (int64_t)(rnd(&seed) % (n * 1000000));
+    ChronoSysUnpackArray(q, qsys, QUERIES);
+
+    chrono_index_t ix;
+    chrono_mno_t start;
+    ChronoMnoNow(&start);
+    ChronoIndexInit(&ix, keys, n);
+    printf("build     %zu keys: %.1f ms, %zu segments\n", n, elapsed(&start) / 1e6, ChronoIndexSegments(&ix));
+
+    sum = 0;
+    ChronoMnoNow(&start);
+    for (size_t i = 0; i < QUERIES; ++i)
+        sum += sysLowerBound(sys, n, &qsys[i]);
+    printf("ChronoSysComp binary search: %6.1f ns/query (%ju)\n", elapsed(&start) / QUERIES, (uintmax_t)sum);
+
+    sum = 0;
+    ChronoMnoNow(&start);
+    for (size_t i = 0; i < QUERIES; ++i)
+        sum += packLowerBound(keys, n, &q[i]);
+    printf("packed binary search:        %6.1f ns/query (%ju)\n", elapsed(&start) / QUERIES, (uintmax_t)sum);
+
+    sum = 0;
+    ChronoMnoNow(&start);
+    for (size_t i = 0; i < QUERIES; ++i)
+        sum += ChronoIndexLowerBound(&ix, &q[i]);
+    printf("ChronoIndexLowerBound:       %6.1f ns/query (%ju)\n", elapsed(&start) / QUERIES, (uintmax_t)sum);
+
+    sum = 0;
+    ChronoMnoNow(&start);
+    ChronoIndexLowerBoundBatch(&ix, q, pos, QUERIES);
+    for (size_t i = 0; i < QUERIES; ++i)
+        sum += pos[i];
+    printf("ChronoIndexLowerBoundBatch:  %6.1f ns/query (%ju)\n", elapsed(&start) / QUERIES, (uintmax_t)sum);
+
+    ChronoIndexDestroy(&ix);
+    free(keys);
+    free(sys);
+    free(q);
+    free(qsys);
+    free(pos);
+}
@@ -0,0 +1,83 @@
+// 区間索引と線形探索の比較: 重なる区間の検索時間
+#include "chrono_interval.h"
+#include "chrono_mno.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define QUERIES 1000
+#define SCANS 20
+#define SPAN (30 * 86400000000000LL)   // 30 日
+
+static uint64_t rnd(uint64_t * seed)
+{
+    *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *seed >> 11;
+}
+
+static double elapsed(chrono_mno_t const * start)
+{
+    chrono_t c;
+    ChronoMnoDiffNow(start, &c);
+    return (double)ChronoGet(&c, chrono_nanoseconds);
+}
+
+int main(int argc, char ** argv)
+{
+    size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : 1000000;
+    chrono_sys_pack_t * starts = malloc(n * sizeof(*starts));
+    chrono_sys_pack_t * ends = malloc(n * sizeof(*ends));
+    uint64_t * ids = malloc(n * sizeof(*ids));
+    uint64_t * out = malloc(n * sizeof(*out));
+    chrono_sys_pack_t base = { 0 };
+    uint64_t seed = 1;
+    ChronoSysPackNow(&base);
+
+    // 1 秒から 10 分のセッション
+    for (size_t i = 0; i < n; ++i) {
+        starts[i].value = base.value + (int64_t)(rnd(&seed) % SPAN);
+        ends[i].value = starts[i].value + 1000000000LL * (1 + (int64_t)(rnd(&seed) % 600));
+        ids[i] = i;
+    }
+
+    chrono_interval_t iv;
+    chrono_mno_t start;
+    ChronoIntervalInit(&iv);
+    ChronoMnoNow(&start);
+    ChronoIntervalBuildPack(&iv, starts, ends, ids, n);
+    printf("build    %zu intervals: %.1f ms\n", n, elapsed(&start) / 1e6);
+
+    int64_t width[] = { 1, 1000000000LL, 60000000000LL };
+    for (size_t w = 0; w < sizeof(width) / sizeof(width[0]); ++w) {
+        chrono_sys_pack_t qs[QUERIES], qe[QUERIES];
+        for (int k = 0; k < QUERIES; ++k) {
+            qs[k].value = base.value + (int64_t)(rnd(&seed) % SPAN);
+            qe[k].value = qs[k].value + width[w];
+        }
+
+        size_t hits = 0, lhits = 0;
+        ChronoMnoNow(&start);
+        for (int k = 0; k < QUERIES; ++k)
+            hits += ChronoIntervalOverlapPack(&iv, &qs[k], &qe[k], out, n);
+        double tree = elapsed(&start) / QUERIES;
+
+        size_t shits = 0;
+        for (int k = 0; k < SCANS; ++k)
+            shits += ChronoIntervalOverlapPack(&iv, &qs[k], &qe[k], out, n);
+
+        ChronoMnoNow(&start);
+        for (int k = 0; k < SCANS; ++k)
+            for (size_t i = 0; i < n; ++i)
+                if (ChronoSysPackComp(&starts[i], &qe[k]) < 0 && ChronoSysPackComp(&qs[k], &ends[i]) < 0)
+                    out[lhits++ % n] = ids[i];
+        double scan = elapsed(&start) / SCANS;
+
+        printf("width %12lld ns: index %10.1f ns/query, scan %12.1f ns/query, %zu hits/query%s\n",
+               (long long)width[w], tree, scan, hits / QUERIES, (shits == lhits) ? "" : " MISMATCH");
+    }
+
+    ChronoIntervalDestroy(&iv);
+    free(starts);
+    free(ends);
+    free(ids);
+    free(out);
+}
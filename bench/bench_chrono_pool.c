@@ -0,0 +1,57 @@
+// 期限順スレッドプールの期限超過率とスループット
+#include "chrono_pool.h"
+#include <sched.h>
+#include <stdio.h>
+
+#define TASKS 200000
+#define BATCH 1000
+
+static _Atomic int done;
+static volatile uint64_t sink;
+
+static void work(void * arg)
+{
+    uint64_t x = (uintptr_t)arg;
+    for (int i = 0; i < 200; ++i)
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    sink = x;
+    atomic_fetch_add_explicit(&done, 1, memory_order_relaxed);
+}
+
+static void run(int workers)
+{
+    chrono_pool_t pool;
+    chrono_mno_t start, deadline;
+    chrono_t c;
+    uint64_t seed = 1;
+
+    atomic_store(&done, 0);
+    ChronoPoolInit(&pool, workers);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < TASKS; i += BATCH) {
+        ChronoMnoNow(&deadline);
+        for (int j = 0; j < BATCH; ++j) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            chrono_mno_t d = deadline;
+            ChronoMnoAddValue(&d, 1000 + (intmax_t)((seed >> 33) % 19000), chrono_microseconds);
+            ChronoPoolSubmit(&pool, &d, work, (void *)(uintptr_t)seed);
+        }
+        while (atomic_load(&done) < i)  // 1 バッチ分の先行で投入する
+            sched_yield();
+    }
+    while (atomic_load(&done) < TASKS)
+        sched_yield();
+    ChronoMnoDiffNow(&start, &c);
+
+    printf("workers %2d: %8.0f tasks/s  miss %5.1f%%  stolen %ju\n", workers,
+           TASKS / ((double)ChronoGet(&c, chrono_nanoseconds) / 1e9),
+           100.0 * ChronoPoolMissed(&pool) / ChronoPoolExecuted(&pool),
+           (uintmax_t)ChronoPoolStolen(&pool));
+    ChronoPoolDestroy(&pool);
+}
+
+int main()
+{
+    for (int w = 1; w <= 8; w *= 2)
+        run(w);
+}
@@ -0,0 +1,51 @@
+// 10万個のキープアライブタイマーの起床回数: slack なしと slack ありの比較 (仮想時間)
+#include "chrono_timer.h"
+#include <stdio.h>
+
+#define TIMERS 100000
+#define SPAN_MS 60000
+
+static void nop(void * arg)
+{
+    (void)arg;
+}
+
+static uint64_t lcg(uint64_t * s)
+{
+    *s = *s * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *s >> 33;
+}
+
+static void run(intmax_t slack_ms)
+{
+    chrono_timer_sched_t ts;
+    chrono_mno_t base, cm, start;
+    chrono_t slack = ChronoInit(slack_ms, chrono_milliseconds);
+    chrono_t c;
+    uint64_t seed = 1;
+
+    ChronoTimerInit(&ts, TIMERS);
+    ChronoMnoZero(&base);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < TIMERS; ++i) {
+        cm = base;
+        ChronoMnoAddValue(&cm, (intmax_t)(lcg(&seed) % ((uint64_t)SPAN_MS * 1000000)), chrono_nanoseconds);
+        ChronoTimerAdd(&ts, &cm, &slack, nop, NULL);
+    }
+    while (ChronoTimerNext(&ts, &cm))
+        ChronoTimerExpire(&ts, &cm);
+    ChronoMnoDiffNow(&start, &c);
+
+    printf("slack %5jd ms: %6ju wakeups (%5.1f%% saved) %6.1f ns/timer\n",
+           slack_ms, (uintmax_t)ChronoTimerWakeups(&ts),
+           100.0 * (TIMERS - (double)ChronoTimerWakeups(&ts)) / TIMERS,
+           (double)ChronoGet(&c, chrono_nanoseconds) / TIMERS);
+    ChronoTimerDestroy(&ts);
+}
+
+int main()
+{
+    static intmax_t const slacks[] = { 0, 1, 10, 100, 1000 };
+    for (size_t i = 0; i < sizeof(slacks) / sizeof(slacks[0]); ++i)
+        run(slacks[i]);
+}
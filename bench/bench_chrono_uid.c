@@ -0,0 +1,43 @@
+// 識別子の発行: 共有変数への CAS とスレッドごとの予約の比較
+#include "chrono_uid.h"
+#include "chrono_mno.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#define COUNT (1 << 20)
+
+static chrono_uid_t uid;
+
+static void * worker(void * arg)
+{
+    uint64_t * sum = arg;
+    for (int i = 0; i < COUNT; ++i)
+        *sum += ChronoUidNext(&uid);
+    return NULL;
+}
+
+static double run(int threads, uint64_t block)
+{
+    pthread_t th[16];
+    uint64_t sum[16] = { 0 };
+    chrono_mno_t start;
+    chrono_t c;
+    ChronoUidInit(&uid, NULL, NULL, CHRONO_UID_WORKER_BITS, CHRONO_UID_SEQUENCE_BITS, 1, block);
+    ChronoMnoNow(&start);
+    for (int i = 0; i < threads; ++i)
+        pthread_create(&th[i], NULL, worker, &sum[i]);
+    for (int i = 0; i < threads; ++i)
+        pthread_join(th[i], NULL);
+    ChronoMnoDiffNow(&start, &c);
+    return (double)COUNT * threads / (double)ChronoGet(&c, chrono_nanoseconds) * 1e3;
+}
+
+int main()
+{
+    printf("%-8s %14s %14s\n", "threads", "CAS", "block 64");
+    for (int t = 1; t <= 16; t *= 2) {
+        double cas = run(t, 1);
+        double block = run(t, 64);
+        printf("%-8d %8.2f M/s %9.2f M/s\n", t, cas, block);
+    }
+}
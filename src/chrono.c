@@ -29,9 +29,11 @@
  * Chrono
  */
 
-intmax_t ChronoGet(chrono_t const * c, chrono_period_t x)
+intmax_t ChronoGet(chrono_t const * c, chrono_period_t cp)
 {
-    chrono_period_t y = c->period;
+    // 倍率の積が int に収まらないので intmax_t で計算する
+    intmax_t x = cp;
+    intmax_t y = c->period;
     if (0 < y) {
         if (0 < x)
             return c->value * y / x;
@@ -229,20 +231,40 @@ static bool specAdd(struct timespec * tv, chrono_t const * c)
     if (c->period < chrono_seconds)
         tv->tv_nsec += ChronoGet(c, chrono_nanoseconds) % -chrono_nanoseconds;
     tv->tv_sec += ChronoGet(c, chrono_seconds);
+
+    // ナノ秒の位を [0, 1秒) に正規化する
+    if (tv->tv_nsec >= -chrono_nanoseconds) {
+        tv->tv_nsec += chrono_nanoseconds;
+        tv->tv_sec += 1;
+    } else if (tv->tv_nsec < 0) {
+        tv->tv_nsec -= chrono_nanoseconds;
+        tv->tv_sec -= 1;
+    }
     return true;
 }
 
 static bool specDiff(struct timespec const * lhs, struct timespec const * rhs, chrono_t * c)
 {
-    int overflow = IS_SUB_OVERFLOW(lhs->tv_sec, rhs->tv_sec, INTMAX_MIN, INTMAX_MAX);
+    int overflow = IS_SUB_OVERFLOW(lhs->tv_sec, rhs->tv_sec, INTMAX_MIN + 1, INTMAX_MAX);
     if (overflow) {
         c->value = INTMAX_MAX;
         c->period = chrono_seconds;
     } else {
-        c->value = llabs(lhs->tv_sec - rhs->tv_sec);
+        intmax_t sec = lhs->tv_sec - rhs->tv_sec;
+        intmax_t nsec = lhs->tv_nsec - rhs->tv_nsec;
+        // 秒とナノ秒の差は符号が異なることがあるので、差の符号をそろえてから絶対値にする
+        if (sec < 0 || (sec == 0 && nsec < 0)) {
+            sec = -sec;
+            nsec = -nsec;
+        }
+        if (nsec < 0) {
+            nsec -= chrono_nanoseconds;
+            sec -= 1;
+        }
+        c->value = sec;
         if (c->value < INTMAX_MAX / -chrono_nanoseconds) {
             c->value *= -chrono_nanoseconds;
-            c->value += llabs(lhs->tv_nsec - rhs->tv_nsec);
+            c->value += nsec;
             c->period = chrono_nanoseconds;
         } else {
             c->period = chrono_seconds;
@@ -705,114 +727,155 @@ int ChronoMnoSleepUntil(chrono_mno_t const * cm, intmax_t value, chrono_period_t
 
 #endif // mno
 /*******************************************************************************
- * ChronoMno
+ * ChronoTimePoint
  */
 
 #if !defined(CHRONO_NO_CLOCK_GETTIME)
-# define cpu(func) cpu_1(spec, func)
-#endif
-
-#ifdef cpu
-# define cpu_1(prefix, func) prefix ## func
-# include "chrono_cpu.h"
-
-void ChronoCpuZero(chrono_cpu_t * cc)
-{
-    cpu(Zero(&cc->time_point));
-}
-
-void ChronoCpuMin(chrono_cpu_t * cc)
-{
-    cpu(Min(&cc->time_point));
-}
-
-void ChronoCpuMax(chrono_cpu_t * cc)
-{
-    cpu(Max(&cc->time_point));
-}
+# include "chrono_time_point.h"
 
-bool ChronoCpuNow(chrono_cpu_t * cc)
-{
-#ifndef CHRONO_NO_CLOCK_GETTIME
-    return cpu(Now(&cc->time_point, CLOCK_PROCESS_CPUTIME_ID));
+#ifndef CHRONO_NO_TIMEVAL
+# define CHRONO_TIME_POINT_DEFINE_TIMEVAL(type, name)                   \
+    void Chrono ## name ## ToTimeVal(type const * tp, struct timeval * tv) \
+    {                                                                   \
+        specToTimeVal(&tp->time_point, tv);                             \
+    }
 #else
-    return cpu(Now(&cc->time_point));
+# define CHRONO_TIME_POINT_DEFINE_TIMEVAL(type, name)
 #endif
 
-}
-
-bool ChronoCpuDHMS(chrono_cpu_t * cc, int days, int hours, int minutes, int seconds)
-{
-    return cpu(DHMS(&cc->time_point, days, hours, minutes, seconds));
-}
-
-void ChronoCpuIncr(chrono_cpu_t * cc)
-{
-    cpu(Incr(&cc->time_point));
-}
+#ifndef CHRONO_NO_TIMESPEC
+# define CHRONO_TIME_POINT_DEFINE_TIMESPEC(type, name)                  \
+    void Chrono ## name ## ToTimeSpec(type const * tp, struct timespec * tv) \
+    {                                                                   \
+        specToTimeSpec(&tp->time_point, tv);                            \
+    }
+#else
+# define CHRONO_TIME_POINT_DEFINE_TIMESPEC(type, name)
+#endif
 
-void ChronoCpuDecr(chrono_cpu_t * cc)
-{
-    cpu(Decr(&cc->time_point));
-}
+#ifndef CHRONO_NO_ANY_SLEEP
+# define CHRONO_TIME_POINT_DEFINE_SLEEP(type, name)                     \
+    int Chrono ## name ## SleepUntil(type const * tp, intmax_t value, chrono_period_t cp) \
+    {                                                                   \
+        chrono_t c1;                                                    \
+        chrono_t c2 = ChronoInit(value, cp);                            \
+        Chrono ## name ## DiffNow(tp, &c1);                             \
+        ChronoSub(&c1, &c2);                                            \
+        c1.value = llabs(c1.value);                                     \
+        return ChronoSleepFor(&c1);                                     \
+    }
+#else
+# define CHRONO_TIME_POINT_DEFINE_SLEEP(type, name)
+#endif
 
-bool ChronoCpuAdd(chrono_cpu_t * cc, chrono_t const * c)
-{
-    return cpu(Add(&cc->time_point, c));
-}
+/*!
+  時刻型 type の関数 Chrono ## name ## Xxx を、時計 clock_id で定義する.
+*/
+#define CHRONO_TIME_POINT_DEFINE(type, name, clock_id)                  \
+    void Chrono ## name ## Zero(type * tp)                              \
+    {                                                                   \
+        specZero(&tp->time_point);                                      \
+    }                                                                   \
+                                                                        \
+    void Chrono ## name ## Min(type * tp)                               \
+    {                                                                   \
+        specMin(&tp->time_point);                                       \
+    }                                                                   \
+                                                                        \
+    void Chrono ## name ## Max(type * tp)                               \
+    {                                                                   \
+        specMax(&tp->time_point);                                       \
+    }                                                                   \
+                                                                        \
+    bool Chrono ## name ## Now(type * tp)                               \
+    {                                                                   \
+        return specNow(&tp->time_point, clock_id);                      \
+    }                                                                   \
+                                                                        \
+    bool Chrono ## name ## DHMS(type * tp, int days, int hours, int minutes, int seconds) \
+    {                                                                   \
+        return specDHMS(&tp->time_point, days, hours, minutes, seconds); \
+    }                                                                   \
+                                                                        \
+    void Chrono ## name ## Incr(type * tp)                              \
+    {                                                                   \
+        specIncr(&tp->time_point);                                      \
+    }                                                                   \
+                                                                        \
+    void Chrono ## name ## Decr(type * tp)                              \
+    {                                                                   \
+        specDecr(&tp->time_point);                                      \
+    }                                                                   \
+                                                                        \
+    bool Chrono ## name ## Add(type * tp, chrono_t const * c)           \
+    {                                                                   \
+        return specAdd(&tp->time_point, c);                             \
+    }                                                                   \
+                                                                        \
+    bool Chrono ## name ## AddValue(type * tp, intmax_t value, chrono_period_t cp) \
+    {                                                                   \
+        chrono_t c = ChronoInit(value, cp);                             \
+        return Chrono ## name ## Add(tp, &c);                           \
+    }                                                                   \
+                                                                        \
+    bool Chrono ## name ## Diff(type const * tp1, type const * tp2, chrono_t * c) \
+    {                                                                   \
+        return specDiff(&tp1->time_point, &tp2->time_point, c);         \
+    }                                                                   \
+                                                                        \
+    bool Chrono ## name ## DiffNow(type const * tp, chrono_t * c)       \
+    {                                                                   \
+        type now;                                                       \
+        Chrono ## name ## Now(&now);                                    \
+        return Chrono ## name ## Diff(tp, &now, c);                     \
+    }                                                                   \
+                                                                        \
+    int Chrono ## name ## Comp(type const * tp1, type const * tp2)      \
+    {                                                                   \
+        return specComp(&tp1->time_point, &tp2->time_point);            \
+    }                                                                   \
+                                                                        \
+    void Chrono ## name ## ToTimeT(type const * tp, time_t * t)         \
+    {                                                                   \
+        specToTimeT(&tp->time_point, t);                                \
+    }                                                                   \
+                                                                        \
+    CHRONO_TIME_POINT_DEFINE_TIMEVAL(type, name)                        \
+    CHRONO_TIME_POINT_DEFINE_TIMESPEC(type, name)                       \
+    CHRONO_TIME_POINT_DEFINE_SLEEP(type, name)
 
-bool ChronoCpuAddValue(chrono_cpu_t * cc, intmax_t value, chrono_period_t cp)
-{
-    chrono_t c = ChronoInit(value, cp);
-    return ChronoCpuAdd(cc, &c);
-}
+/*******************************************************************************
+ * ChronoCpu
+ */
 
-bool ChronoCpuDiff(chrono_cpu_t const * cc1, chrono_cpu_t const * cc2, chrono_t * c)
-{
-    return cpu(Diff(&cc1->time_point, &cc2->time_point, c));
-}
+# include "chrono_cpu.h"
+CHRONO_TIME_POINT_DEFINE(chrono_cpu_t, Cpu, CLOCK_PROCESS_CPUTIME_ID)
 
-bool ChronoCpuDiffNow(chrono_cpu_t const * cc, chrono_t * c)
-{
-    chrono_cpu_t now;
-    ChronoCpuNow(&now);
-    return ChronoCpuDiff(cc, &now, c);
-}
+/*******************************************************************************
+ * ChronoBoot
+ */
 
-int ChronoCpuComp(chrono_cpu_t const * cc1, chrono_cpu_t const * cc2)
-{
-    return cpu(Comp(&cc1->time_point, &cc2->time_point));
-}
+# if defined(CLOCK_BOOTTIME)
+#  include "chrono_boot.h"
+CHRONO_TIME_POINT_DEFINE(chrono_boot_t, Boot, CLOCK_BOOTTIME)
+# endif
 
-void ChronoCpuToTimeT(chrono_cpu_t const * cc, time_t * t)
-{
-    cpu(ToTimeT(&cc->time_point, t));
-}
+/*******************************************************************************
+ * ChronoRaw
+ */
 
-#ifndef CHRONO_NO_TIMEVAL
-void ChronoCpuToTimeVal(chrono_cpu_t const * cc, struct timeval * tv)
-{
-    cpu(ToTimeVal(&cc->time_point, tv));
-}
-#endif
+# if defined(CLOCK_MONOTONIC_RAW)
+#  include "chrono_raw.h"
+CHRONO_TIME_POINT_DEFINE(chrono_raw_t, Raw, CLOCK_MONOTONIC_RAW)
+# endif
 
-#ifndef CHRONO_NO_TIMESPEC
-void ChronoCpuToTimeSpec(chrono_cpu_t const * cc, struct timespec * tv)
-{
-    cpu(ToTimeSpec(&cc->time_point, tv));
-}
-#endif
+/*******************************************************************************
+ * ChronoTai
+ */
 
-#ifndef CHRONO_NO_ANY_SLEEP
-int ChronoCpuSleepUntil(chrono_cpu_t const * cc, intmax_t value, chrono_period_t cp)
-{
-    chrono_t c1;
-    chrono_t c2 = ChronoInit(value, cp);
-    ChronoCpuDiffNow(cc, &c1);
-    ChronoSub(&c1, &c2);
-    c1.value = llabs(c1.value);
-    return ChronoSleepFor(&c1);
-}
-#endif
+# if defined(CLOCK_TAI)
+#  include "chrono_tai.h"
+CHRONO_TIME_POINT_DEFINE(chrono_tai_t, Tai, CLOCK_TAI)
+# endif
 
-#endif  // cpu
+#endif // ChronoTimePoint
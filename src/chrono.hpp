@@ -0,0 +1,387 @@
+/*! @file
+  Chrono : C++ ラッパー
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  chrono_t と chrono_sys_t 、 chrono_mno_t 、 chrono_cpu_t を constexpr な値型で包む (C++17 以降).
+  期間は倍率をテンプレート引数に持ち、倍率の変換はコンパイル時に行う.
+  時刻は 64 ビットのナノ秒で保持するため、演算は整数演算と同じコードになる.
+  std::chrono::duration / std::chrono::time_point とは暗黙に相互変換できる.
+
+  @code
+  Chrono::mno_time start = Chrono::mno_time::now();
+  ...
+  Chrono::milliseconds elapsed = Chrono::duration_cast<Chrono::milliseconds>(Chrono::mno_time::now() - start);
+  std::this_thread::sleep_for(elapsed);  // std::chrono::milliseconds に変換される
+  @endcode
+*/
+
+#ifndef CHRONO_HPP
+#define CHRONO_HPP
+
+extern "C" {
+#include "chrono.h"
+#include "chrono_sys.h"
+#include "chrono_mno.h"
+#include "chrono_cpu.h"
+}
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled Chrono C++ wrapper"
+#endif
+
+namespace Chrono {
+
+namespace detail {
+
+/*!
+  倍率 Period を時間倍率に変換する.
+ */
+template <class Period>
+constexpr chrono_period_t to_period() noexcept
+{
+    static_assert(Period::num == 1 || Period::den == 1, "Period is not representable as chrono_period_t");
+    return static_cast<chrono_period_t>(Period::den == 1 ? Period::num : -Period::den);
+}
+
+/*!
+  倍率 From から To へ誤差なく変換できるか?
+ */
+template <class From, class To>
+constexpr bool is_lossless = std::ratio_divide<From, To>::den == 1;
+
+/*!
+  倍率 From の値 v を倍率 To に変換する. 小さい位は切り捨てられる
+ */
+template <class From, class To>
+constexpr std::int64_t convert(std::int64_t v) noexcept
+{
+    using r = std::ratio_divide<From, To>;
+    if constexpr (r::num == 1 && r::den == 1)
+        return v;
+    else if constexpr (r::den == 1)
+        return v * r::num;
+    else if constexpr (r::num == 1)
+        return v / r::den;
+    else
+        return v * r::num / r::den;
+}
+
+template <class P1, class P2>
+using common_period = typename std::common_type<std::chrono::duration<std::int64_t, P1>,
+                                                std::chrono::duration<std::int64_t, P2>>::type::period;
+
+}  // namespace detail
+
+
+/*!
+  期間.
+  倍率 Period の値を 64 ビットで保持する
+ */
+template <class Period>
+class duration {
+public:
+    using rep = std::int64_t;
+    using period = typename Period::type;
+
+    constexpr duration() noexcept = default;
+
+    constexpr explicit duration(rep count) noexcept
+        : count_(count) {}
+
+    //! 誤差なく変換できる期間からの暗黙の変換
+    template <class P2, std::enable_if_t<detail::is_lossless<P2, period>, int> = 0>
+    constexpr duration(duration<P2> const & d) noexcept
+        : count_(detail::convert<P2, period>(d.count())) {}
+
+    //! 誤差なく変換できる(整数の) std::chrono::duration からの暗黙の変換
+    template <class R, class P2, std::enable_if_t<detail::is_lossless<P2, period>
+                                                  && !std::chrono::treat_as_floating_point_v<R>, int> = 0>
+    constexpr duration(std::chrono::duration<R, P2> const & d) noexcept
+        : count_(detail::convert<P2, period>(static_cast<rep>(d.count()))) {}
+
+    //! 浮動小数点の std::chrono::duration からの変換. 小さい位は切り捨てられる
+    template <class R, class P2, std::enable_if_t<std::chrono::treat_as_floating_point_v<R>, int> = 0>
+    constexpr explicit duration(std::chrono::duration<R, P2> const & d) noexcept
+        : count_(std::chrono::duration_cast<std::chrono::duration<rep, period>>(d).count()) {}
+
+    //! 期間 chrono_t からの変換. 小さい位は切り捨てられる
+    explicit duration(chrono_t const & c) noexcept
+        : count_(ChronoGet(&c, detail::to_period<period>())) {}
+
+    //! 誤差なく変換できる(もしくは浮動小数点の) std::chrono::duration への暗黙の変換
+    template <class R, class P2, std::enable_if_t<detail::is_lossless<period, P2>
+                                                  || std::chrono::treat_as_floating_point_v<R>, int> = 0>
+    constexpr operator std::chrono::duration<R, P2>() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::duration<R, P2>>(std::chrono::duration<rep, period>(count_));
+    }
+
+    //! 期間 chrono_t への変換
+    constexpr operator chrono_t() const noexcept
+    {
+        return chrono_t{ count_, detail::to_period<period>() };
+    }
+
+    constexpr rep count() const noexcept { return count_; }
+
+    static constexpr duration zero() noexcept { return duration(0); }
+    static constexpr duration min() noexcept { return duration(INT64_MIN); }
+    static constexpr duration max() noexcept { return duration(INT64_MAX); }
+
+    constexpr duration operator+() const noexcept { return *this; }
+    constexpr duration operator-() const noexcept { return duration(-count_); }
+
+    constexpr duration & operator+=(duration const & d) noexcept { count_ += d.count_; return *this; }
+    constexpr duration & operator-=(duration const & d) noexcept { count_ -= d.count_; return *this; }
+    constexpr duration & operator*=(rep n) noexcept { count_ *= n; return *this; }
+    constexpr duration & operator/=(rep n) noexcept { count_ /= n; return *this; }
+    constexpr duration & operator%=(rep n) noexcept { count_ %= n; return *this; }
+
+private:
+    rep count_ = 0;
+};
+
+using nanoseconds  = duration<std::nano>;
+using microseconds = duration<std::micro>;
+using milliseconds = duration<std::milli>;
+using seconds      = duration<std::ratio<1>>;
+using minutes      = duration<std::ratio<60>>;
+using hours        = duration<std::ratio<3600>>;
+using days         = duration<std::ratio<86400>>;
+
+
+/*!
+  期間 d を期間 To に変換する. 小さい位は切り捨てられる
+ */
+template <class To, class P>
+constexpr To duration_cast(duration<P> const & d) noexcept
+{
+    return To(detail::convert<P, typename To::period>(d.count()));
+}
+
+template <class P1, class P2>
+constexpr auto operator+(duration<P1> const & lhs, duration<P2> const & rhs) noexcept
+{
+    using cp = detail::common_period<P1, P2>;
+    return duration<cp>(detail::convert<P1, cp>(lhs.count()) + detail::convert<P2, cp>(rhs.count()));
+}
+
+template <class P1, class P2>
+constexpr auto operator-(duration<P1> const & lhs, duration<P2> const & rhs) noexcept
+{
+    using cp = detail::common_period<P1, P2>;
+    return duration<cp>(detail::convert<P1, cp>(lhs.count()) - detail::convert<P2, cp>(rhs.count()));
+}
+
+template <class P>
+constexpr duration<P> operator*(duration<P> const & d, std::int64_t n) noexcept
+{
+    return duration<P>(d.count() * n);
+}
+
+template <class P>
+constexpr duration<P> operator*(std::int64_t n, duration<P> const & d) noexcept
+{
+    return duration<P>(d.count() * n);
+}
+
+template <class P>
+constexpr duration<P> operator/(duration<P> const & d, std::int64_t n) noexcept
+{
+    return duration<P>(d.count() / n);
+}
+
+template <class P1, class P2>
+constexpr std::int64_t operator/(duration<P1> const & lhs, duration<P2> const & rhs) noexcept
+{
+    using cp = detail::common_period<P1, P2>;
+    return detail::convert<P1, cp>(lhs.count()) / detail::convert<P2, cp>(rhs.count());
+}
+
+template <class P>
+constexpr duration<P> operator%(duration<P> const & d, std::int64_t n) noexcept
+{
+    return duration<P>(d.count() % n);
+}
+
+#define CHRONO_HPP_DURATION_COMPARE(op)                                 \
+    template <class P1, class P2>                                       \
+    constexpr bool operator op(duration<P1> const & lhs, duration<P2> const & rhs) noexcept \
+    {                                                                   \
+        using cp = detail::common_period<P1, P2>;                       \
+        return detail::convert<P1, cp>(lhs.count()) op detail::convert<P2, cp>(rhs.count()); \
+    }
+CHRONO_HPP_DURATION_COMPARE(==)
+CHRONO_HPP_DURATION_COMPARE(!=)
+CHRONO_HPP_DURATION_COMPARE(<)
+CHRONO_HPP_DURATION_COMPARE(<=)
+CHRONO_HPP_DURATION_COMPARE(>)
+CHRONO_HPP_DURATION_COMPARE(>=)
+#undef CHRONO_HPP_DURATION_COMPARE
+
+
+/*!
+  システム時刻の時計.
+ */
+struct sys_clock {
+    using c_type = chrono_sys_t;
+    using std_clock = std::chrono::system_clock;
+    static bool now(c_type * tp) noexcept { return ChronoSysNow(tp); }
+};
+
+/*!
+  モノトニック時刻の時計.
+  libstdc++ の std::chrono::steady_clock は CLOCK_MONOTONIC を用いる
+ */
+struct mno_clock {
+    using c_type = chrono_mno_t;
+    using std_clock = std::chrono::steady_clock;
+    static bool now(c_type * tp) noexcept { return ChronoMnoNow(tp); }
+};
+
+/*!
+  CPU時刻の時計. 対応する std::chrono の時計はない
+ */
+struct cpu_clock {
+    using c_type = chrono_cpu_t;
+    using std_clock = void;
+    static bool now(c_type * tp) noexcept { return ChronoCpuNow(tp); }
+};
+
+
+/*!
+  時刻.
+  時計 Clock の起点からのナノ秒を保持する
+ */
+template <class Clock>
+class time_point {
+public:
+    using clock = Clock;
+    using duration = nanoseconds;
+    using c_type = typename Clock::c_type;
+
+    constexpr time_point() noexcept = default;
+
+    constexpr explicit time_point(duration d) noexcept
+        : d_(d) {}
+
+    //! C の時刻型からの暗黙の変換
+    constexpr time_point(c_type const & c) noexcept
+        : d_(static_cast<std::int64_t>(c.time_point.tv_sec) * 1000000000 + c.time_point.tv_nsec) {}
+
+    //! 同じ時計の std::chrono::time_point からの変換. 期間の変換規則は duration と同じ
+    template <class D, class C = Clock, std::enable_if_t<!std::is_void_v<typename C::std_clock>
+                                                         && std::is_convertible_v<D, duration>, int> = 0>
+    constexpr time_point(std::chrono::time_point<typename C::std_clock, D> const & tp) noexcept
+        : d_(tp.time_since_epoch()) {}
+
+    template <class D, class C = Clock, std::enable_if_t<!std::is_void_v<typename C::std_clock>
+                                                         && !std::is_convertible_v<D, duration>
+                                                         && std::is_constructible_v<duration, D>, int> = 0>
+    constexpr explicit time_point(std::chrono::time_point<typename C::std_clock, D> const & tp) noexcept
+        : d_(tp.time_since_epoch()) {}
+
+    //! C の時刻型への暗黙の変換
+    constexpr operator c_type() const noexcept
+    {
+        std::int64_t sec = d_.count() / 1000000000;
+        std::int64_t nsec = d_.count() % 1000000000;
+        if (nsec < 0) {
+            sec -= 1;
+            nsec += 1000000000;
+        }
+        c_type c{};
+        c.time_point.tv_sec = sec;
+        c.time_point.tv_nsec = nsec;
+        return c;
+    }
+
+    //! 同じ時計の、誤差なく変換できる(もしくは浮動小数点の)期間の std::chrono::time_point への暗黙の変換
+    template <class D, class C = Clock, std::enable_if_t<!std::is_void_v<typename C::std_clock>
+                                                         && std::is_convertible_v<duration, D>, int> = 0>
+    constexpr operator std::chrono::time_point<typename C::std_clock, D>() const noexcept
+    {
+        return std::chrono::time_point<typename C::std_clock, D>(D(d_));
+    }
+
+    //! 同じ時計の std::chrono::time_point への明示的な変換. 小さい位は切り捨てられる
+    template <class D, class C = Clock, std::enable_if_t<!std::is_void_v<typename C::std_clock>
+                                                         && !std::is_convertible_v<duration, D>, int> = 0>
+    constexpr explicit operator std::chrono::time_point<typename C::std_clock, D>() const noexcept
+    {
+        return std::chrono::time_point<typename C::std_clock, D>(
+            std::chrono::duration_cast<D>(std::chrono::nanoseconds(d_.count())));
+    }
+
+    static time_point now() noexcept
+    {
+        c_type c;
+        Clock::now(&c);
+        return time_point(c);
+    }
+
+    static constexpr time_point min() noexcept { return time_point(duration::min()); }
+    static constexpr time_point max() noexcept { return time_point(duration::max()); }
+
+    constexpr duration time_since_epoch() const noexcept { return d_; }
+
+    constexpr time_point & operator+=(duration const & d) noexcept { d_ += d; return *this; }
+    constexpr time_point & operator-=(duration const & d) noexcept { d_ -= d; return *this; }
+
+private:
+    duration d_;
+};
+
+using sys_time = time_point<sys_clock>;
+using mno_time = time_point<mno_clock>;
+using cpu_time = time_point<cpu_clock>;
+
+template <class C, class P>
+constexpr time_point<C> operator+(time_point<C> const & tp, duration<P> const & d) noexcept
+{
+    return time_point<C>(tp.time_since_epoch() + nanoseconds(d));
+}
+
+template <class C, class P>
+constexpr time_point<C> operator+(duration<P> const & d, time_point<C> const & tp) noexcept
+{
+    return tp + d;
+}
+
+template <class C, class P>
+constexpr time_point<C> operator-(time_point<C> const & tp, duration<P> const & d) noexcept
+{
+    return time_point<C>(tp.time_since_epoch() - nanoseconds(d));
+}
+
+template <class C>
+constexpr nanoseconds operator-(time_point<C> const & lhs, time_point<C> const & rhs) noexcept
+{
+    return lhs.time_since_epoch() - rhs.time_since_epoch();
+}
+
+#define CHRONO_HPP_TIME_POINT_COMPARE(op)                               \
+    template <class C>                                                  \
+    constexpr bool operator op(time_point<C> const & lhs, time_point<C> const & rhs) noexcept \
+    {                                                                   \
+        return lhs.time_since_epoch().count() op rhs.time_since_epoch().count(); \
+    }
+CHRONO_HPP_TIME_POINT_COMPARE(==)
+CHRONO_HPP_TIME_POINT_COMPARE(!=)
+CHRONO_HPP_TIME_POINT_COMPARE(<)
+CHRONO_HPP_TIME_POINT_COMPARE(<=)
+CHRONO_HPP_TIME_POINT_COMPARE(>)
+CHRONO_HPP_TIME_POINT_COMPARE(>=)
+#undef CHRONO_HPP_TIME_POINT_COMPARE
+
+}  // namespace Chrono
+
+#endif // CHRONO_HPP
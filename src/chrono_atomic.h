@@ -0,0 +1,199 @@
+/*! @file
+  Chrono : アトミックなモノトニック時刻モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  chrono_mno_t は 16 バイトの struct timespec なので、アトミックに読み書きできない.
+  そこで chrono_mno_pack_t の 64 ビット表現を C11 のアトミック変数で保持し、
+  複数スレッドから最終アクセス時刻などを、ロックなしで記録する.
+*/
+
+#ifndef CHRONO_ATOMIC_H
+#define CHRONO_ATOMIC_H
+
+#include "chrono_pack.h"
+#include <stdatomic.h>
+
+/*!
+  アトミックなモノトニック時刻.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic int64_t value;  //!< chrono_mno_pack_t の値
+} chrono_mno_atomic_t;
+
+
+/*!
+  アトミック時刻 a を圧縮時刻 p で初期化する.
+ */
+static inline void ChronoMnoAtomicInitPack(chrono_mno_atomic_t * a, chrono_mno_pack_t const * p)
+{
+    atomic_init(&a->value, p->value);
+}
+
+
+/*!
+  アトミック時刻 a をモノトニック時刻 cm で初期化する.
+ */
+static inline void ChronoMnoAtomicInit(chrono_mno_atomic_t * a, chrono_mno_t const * cm)
+{
+    chrono_mno_pack_t p;
+    ChronoMnoPack(cm, &p);
+    ChronoMnoAtomicInitPack(a, &p);
+}
+
+
+/*!
+  アトミック時刻 a に圧縮時刻 p を書き込む.
+ */
+static inline void ChronoMnoAtomicStorePack(chrono_mno_atomic_t * a, chrono_mno_pack_t const * p)
+{
+    atomic_store_explicit(&a->value, p->value, memory_order_release);
+}
+
+
+/*!
+  アトミック時刻 a にモノトニック時刻 cm を書き込む.
+ */
+static inline void ChronoMnoAtomicStore(chrono_mno_atomic_t * a, chrono_mno_t const * cm)
+{
+    chrono_mno_pack_t p;
+    ChronoMnoPack(cm, &p);
+    ChronoMnoAtomicStorePack(a, &p);
+}
+
+
+/*!
+  アトミック時刻 a を圧縮時刻 p に読み出す.
+ */
+static inline void ChronoMnoAtomicLoadPack(chrono_mno_atomic_t const * a, chrono_mno_pack_t * p)
+{
+    p->value = atomic_load_explicit((_Atomic int64_t *)&a->value, memory_order_acquire);
+}
+
+
+/*!
+  アトミック時刻 a をモノトニック時刻 cm に読み出す.
+ */
+static inline void ChronoMnoAtomicLoad(chrono_mno_atomic_t const * a, chrono_mno_t * cm)
+{
+    chrono_mno_pack_t p;
+    ChronoMnoAtomicLoadPack(a, &p);
+    ChronoMnoUnpack(&p, cm);
+}
+
+
+/*!
+  アトミック時刻 a が圧縮時刻 p より前の場合のみ p に更新する.
+  更新した場合は true を返す. old が NULL でなければ、更新前の値を設定する
+  既に新しい時刻が書かれている場合は、書き込まないので競合しない
+ */
+static inline bool ChronoMnoAtomicFetchMaxPack(chrono_mno_atomic_t * a, chrono_mno_pack_t const * p, chrono_mno_pack_t * old)
+{
+    int64_t cur = atomic_load_explicit(&a->value, memory_order_relaxed);
+    while (cur < p->value) {
+        if (atomic_compare_exchange_weak_explicit(&a->value, &cur, p->value,
+                                                  memory_order_release, memory_order_relaxed)) {
+            if (old)
+                old->value = cur;
+            return true;
+        }
+    }
+    if (old)
+        old->value = cur;
+    return false;
+}
+
+
+/*!
+  アトミック時刻 a がモノトニック時刻 cm より前の場合のみ cm に更新する.
+  更新した場合は true を返す. old が NULL でなければ、更新前の値を設定する
+ */
+static inline bool ChronoMnoAtomicFetchMax(chrono_mno_atomic_t * a, chrono_mno_t const * cm, chrono_mno_t * old)
+{
+    chrono_mno_pack_t p, o;
+    ChronoMnoPack(cm, &p);
+    bool updated = ChronoMnoAtomicFetchMaxPack(a, &p, &o);
+    if (old)
+        ChronoMnoUnpack(&o, old);
+    return updated;
+}
+
+
+/*!
+  アトミック時刻 a を現在のモノトニック時刻に更新する. 時刻は戻らない
+ */
+static inline bool ChronoMnoAtomicTouch(chrono_mno_atomic_t * a)
+{
+    chrono_mno_pack_t now;
+    if (!ChronoMnoPackNow(&now))
+        return false;
+    ChronoMnoAtomicFetchMaxPack(a, &now, NULL);
+    return true;
+}
+
+
+/*!
+  アトミック時刻 a が圧縮時刻 expected と等しい場合のみ desired に置き換える.
+  置き換えられなかった場合は、false を返し、現在の値を expected に設定する
+ */
+static inline bool ChronoMnoAtomicCompareExchangePack(chrono_mno_atomic_t * a, chrono_mno_pack_t * expected, chrono_mno_pack_t const * desired)
+{
+    return atomic_compare_exchange_strong_explicit(&a->value, &expected->value, desired->value,
+                                                   memory_order_acq_rel, memory_order_acquire);
+}
+
+
+/*!
+  アトミック時刻 a がモノトニック時刻 expected と等しい場合のみ desired に置き換える.
+  置き換えられなかった場合は、false を返し、現在の値を expected に設定する
+ */
+static inline bool ChronoMnoAtomicCompareExchange(chrono_mno_atomic_t * a, chrono_mno_t * expected, chrono_mno_t const * desired)
+{
+    chrono_mno_pack_t e, d;
+    ChronoMnoPack(expected, &e);
+    ChronoMnoPack(desired, &d);
+    if (ChronoMnoAtomicCompareExchangePack(a, &e, &d))
+        return true;
+    ChronoMnoUnpack(&e, expected);
+    return false;
+}
+
+
+/*!
+  アトミック時刻 a がモノトニック時刻 cm より小さいと <0, 大きいと 0< を返す.
+ */
+static inline int ChronoMnoAtomicComp(chrono_mno_atomic_t const * a, chrono_mno_t const * cm)
+{
+    chrono_mno_pack_t p1, p2;
+    ChronoMnoAtomicLoadPack(a, &p1);
+    ChronoMnoPack(cm, &p2);
+    return ChronoMnoPackComp(&p1, &p2);
+}
+
+
+/*!
+  アトミック時刻 a - モノトニック時刻 cm 間の時間差(絶対値)を c に設定する.
+ */
+static inline bool ChronoMnoAtomicDiff(chrono_mno_atomic_t const * a, chrono_mno_t const * cm, chrono_t * c)
+{
+    chrono_mno_pack_t p1, p2;
+    ChronoMnoAtomicLoadPack(a, &p1);
+    ChronoMnoPack(cm, &p2);
+    return ChronoMnoPackDiff(&p1, &p2, c);
+}
+
+
+/*!
+  アトミック時刻 a - 現在時刻までの時間差(絶対値)を c に設定する.
+ */
+static inline bool ChronoMnoAtomicDiffNow(chrono_mno_atomic_t const * a, chrono_t * c)
+{
+    chrono_mno_pack_t p;
+    ChronoMnoAtomicLoadPack(a, &p);
+    return ChronoMnoPackDiffNow(&p, c);
+}
+
+#endif // CHRONO_ATOMIC_H
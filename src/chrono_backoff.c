@@ -0,0 +1,156 @@
+/*! @file
+  Chrono : 再試行間隔の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_backoff.h"
+#include "chrono_pack.h"
+
+static _Thread_local uint64_t backoffState[4];
+static _Thread_local bool backoffSeeded;
+
+static uint64_t backoffSplitMix(uint64_t * x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t backoffRotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/*!
+  xoshiro256**
+ */
+static uint64_t backoffRandom(void)
+{
+    if (!backoffSeeded) {
+        // スレッド毎に異なるように、時刻とスレッド局所変数のアドレスを混ぜる
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ChronoBackoffSeed((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec + (uintptr_t)backoffState);
+    }
+    uint64_t * s = backoffState;
+    uint64_t result = backoffRotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = backoffRotl(s[3], 45);
+    return result;
+}
+
+/*!
+  [lo, hi] の一様乱数.
+ */
+static int64_t backoffUniform(int64_t lo, int64_t hi)
+{
+    if (hi <= lo)
+        return lo;
+    uint64_t range = (uint64_t)(hi - lo) + 1;
+    return lo + (int64_t)(((unsigned __int128)backoffRandom() * range) >> 64);
+}
+
+/*!
+  min(cap, base * 2^attempt).
+ */
+static int64_t backoffExp(int64_t base, int64_t cap, uint32_t attempt)
+{
+    if (attempt >= 63 || base > (cap >> attempt))
+        return cap;
+    return base << attempt;
+}
+
+static int64_t backoffStep(chrono_backoff_t * bo)
+{
+    int64_t d;
+    switch (bo->policy) {
+    case chrono_backoff_full_jitter:
+        d = backoffUniform(0, backoffExp(bo->base, bo->cap, bo->attempt));
+        break;
+    case chrono_backoff_decorrelated: {
+        int64_t hi = (bo->prev > INT64_MAX / 3) ? INT64_MAX : bo->prev * 3;
+        d = backoffUniform(bo->base, hi);
+        if (d > bo->cap)
+            d = bo->cap;
+        break;
+    }
+    default:
+        d = backoffExp(bo->base, bo->cap, bo->attempt);
+        break;
+    }
+    bo->prev = d;
+    if (bo->attempt < UINT32_MAX)
+        ++bo->attempt;
+    return d;
+}
+
+void ChronoBackoffSeed(uint64_t seed)
+{
+    for (int i = 0; i < 4; ++i)
+        backoffState[i] = backoffSplitMix(&seed);
+    backoffSeeded = true;
+}
+
+bool ChronoBackoffInit(chrono_backoff_t * bo, chrono_backoff_policy_t policy, chrono_t const * base, chrono_t const * cap)
+{
+    int64_t b = 0, c = 0;
+    ChronoPackFromChrono(base, &b);
+    ChronoPackFromChrono(cap, &c);
+    if (b <= 0 || c < b)
+        return false;
+    bo->policy = policy;
+    bo->base = b;
+    bo->cap = c;
+    ChronoBackoffReset(bo);
+    return true;
+}
+
+void ChronoBackoffReset(chrono_backoff_t * bo)
+{
+    bo->prev = bo->base;
+    bo->attempt = 0;
+}
+
+uint32_t ChronoBackoffAttempts(chrono_backoff_t const * bo)
+{
+    return bo->attempt;
+}
+
+void ChronoBackoffNext(chrono_backoff_t * bo, chrono_t * delay)
+{
+    *delay = ChronoInit(backoffStep(bo), chrono_nanoseconds);
+}
+
+bool ChronoBackoffDeadline(chrono_backoff_t * bo, chrono_mno_t * deadline)
+{
+    chrono_mno_pack_t p;
+    if (!ChronoMnoPackNow(&p))
+        return false;
+    int64_t d = backoffStep(bo);
+    p.value = (p.value > INT64_MAX - d) ? INT64_MAX : p.value + d;
+    ChronoMnoUnpack(&p, deadline);
+    return true;
+}
+
+int ChronoBackoffSleep(chrono_backoff_t * bo)
+{
+    chrono_t delay;
+    ChronoBackoffNext(bo, &delay);
+    return ChronoSleepFor(&delay);
+}
+
+void ChronoBackoffSchedule(chrono_backoff_t const * bo, chrono_t * delays, size_t n)
+{
+    chrono_backoff_t tmp = *bo;
+    for (size_t i = 0; i < n; ++i)
+        ChronoBackoffNext(&tmp, &delays[i]);
+}
@@ -0,0 +1,92 @@
+/*! @file
+  Chrono : 再試行間隔モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  再試行の待ち時間を、指数・フルジッター・非相関ジッターの方式で求める.
+  乱数はスレッド毎の xoshiro256** で、ロックを取らない. 計算はすべて整数で行う
+*/
+
+#ifndef CHRONO_BACKOFF_H
+#define CHRONO_BACKOFF_H
+
+#include "chrono_mno.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoBackoff"
+#endif
+
+/*!
+  待ち時間の方式.
+ */
+typedef enum {
+    chrono_backoff_exponential,   //!< min(cap, base * 2^n)
+    chrono_backoff_full_jitter,   //!< [0, min(cap, base * 2^n)] の一様乱数
+    chrono_backoff_decorrelated,  //!< min(cap, [base, 前回 * 3] の一様乱数)
+} chrono_backoff_policy_t;
+
+
+/*!
+  再試行間隔.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    chrono_backoff_policy_t policy;  //!< 方式
+    int64_t base;                    //!< 基準の待ち時間(ナノ秒)
+    int64_t cap;                     //!< 最大の待ち時間(ナノ秒)
+    int64_t prev;                    //!< 前回の待ち時間(ナノ秒)
+    uint32_t attempt;                //!< 試行回数
+} chrono_backoff_t;
+
+
+/*!
+  再試行間隔 bo を方式 policy, 基準 base, 最大 cap で初期化する.
+ */
+extern bool ChronoBackoffInit(chrono_backoff_t * bo, chrono_backoff_policy_t policy, chrono_t const * base, chrono_t const * cap);
+
+
+/*!
+  再試行間隔 bo を最初の試行に戻す.
+ */
+extern void ChronoBackoffReset(chrono_backoff_t * bo);
+
+
+/*!
+  再試行間隔 bo の試行回数を返す.
+ */
+extern uint32_t ChronoBackoffAttempts(chrono_backoff_t const * bo);
+
+
+/*!
+  再試行間隔 bo の次の待ち時間を delay に設定する.
+ */
+extern void ChronoBackoffNext(chrono_backoff_t * bo, chrono_t * delay);
+
+
+/*!
+  再試行間隔 bo の次の待ち時間後のモノトニック時刻を deadline に設定する.
+ */
+extern bool ChronoBackoffDeadline(chrono_backoff_t * bo, chrono_mno_t * deadline);
+
+
+/*!
+  再試行間隔 bo の次の待ち時間だけ sleep する.
+ */
+extern int ChronoBackoffSleep(chrono_backoff_t * bo);
+
+
+/*!
+  再試行間隔 bo のこれから n 回分の待ち時間を delays に設定する. bo は変更しない.
+  ジッターのある方式では、呼び出したスレッドの乱数を消費する
+ */
+extern void ChronoBackoffSchedule(chrono_backoff_t const * bo, chrono_t * delays, size_t n);
+
+
+/*!
+  呼び出したスレッドの乱数を seed で初期化する. 再現性のある試験用
+ */
+extern void ChronoBackoffSeed(uint64_t seed);
+
+#endif // CHRONO_BACKOFF_H
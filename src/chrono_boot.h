@@ -0,0 +1,27 @@
+/*! @file
+  Chrono : ブートタイム時間モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+*/
+
+#ifndef CHRONO_BOOT_H
+#define CHRONO_BOOT_H
+
+#include "chrono_time_point.h"
+
+/*!
+  ブートタイム時刻.
+  CLOCK_BOOTTIME を用いる. モノトニック時刻と異なり、サスペンド中も進む.
+ */
+#if !defined(CLOCK_BOOTTIME)
+# error "Undeclared CLOCK_BOOTTIME"
+#endif
+typedef struct {
+    struct timespec time_point;
+} chrono_boot_t;
+
+CHRONO_TIME_POINT_DECLARE(chrono_boot_t, Boot)
+
+#endif // CHRONO_BOOT_H
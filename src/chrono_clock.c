@@ -0,0 +1,205 @@
+/*! @file
+  Chrono : 時計の性能調査の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // CLOCK_MONOTONIC_RAW, CLOCK_MONOTONIC_COARSE, CLOCK_BOOTTIME
+#endif
+#include "chrono_clock.h"
+#include "chrono_tsc.h"
+
+//! 読み出し時間を測定する回数
+#define CHRONO_CLOCK_PROBE_CALLS 1000
+
+//! 読み出し時間の測定を繰り返す回数(最小値を採用する)
+#define CHRONO_CLOCK_PROBE_ROUNDS 5
+
+static chrono_tsc_t clock_tsc;
+
+static bool clockMonotonic(chrono_clock_t * ct)
+{
+    return ChronoMnoNow(&ct->mno);
+}
+
+#if defined(CLOCK_MONOTONIC_RAW)
+static bool clockMonotonicRaw(chrono_clock_t * ct)
+{
+    return ChronoRawNow(&ct->raw);
+}
+#endif
+
+#if defined(CLOCK_MONOTONIC_COARSE)
+static bool clockMonotonicCoarse(chrono_clock_t * ct)
+{
+    return clock_gettime(CLOCK_MONOTONIC_COARSE, &ct->mno.time_point) == 0;
+}
+#endif
+
+#if defined(CLOCK_BOOTTIME)
+static bool clockBoottime(chrono_clock_t * ct)
+{
+    return ChronoBootNow(&ct->boot);
+}
+#endif
+
+static bool clockTsc(chrono_clock_t * ct)
+{
+    ChronoTscToMno(&clock_tsc, ChronoTscRead(), &ct->mno);
+    return true;
+}
+
+/*!
+  時計の分派表.
+ */
+static struct {
+    char const * name;
+    bool (*now)(chrono_clock_t *);
+    clockid_t id;
+} const clock_table[chrono_clock_count] = {
+    { "MONOTONIC",        clockMonotonic,       CLOCK_MONOTONIC },
+#if defined(CLOCK_MONOTONIC_RAW)
+    { "MONOTONIC_RAW",    clockMonotonicRaw,    CLOCK_MONOTONIC_RAW },
+#else
+    { "MONOTONIC_RAW",    NULL,                 -1 },
+#endif
+#if defined(CLOCK_MONOTONIC_COARSE)
+    { "MONOTONIC_COARSE", clockMonotonicCoarse, CLOCK_MONOTONIC_COARSE },
+#else
+    { "MONOTONIC_COARSE", NULL,                 -1 },
+#endif
+#if defined(CLOCK_BOOTTIME)
+    { "BOOTTIME",         clockBoottime,        CLOCK_BOOTTIME },
+#else
+    { "BOOTTIME",         NULL,                 -1 },
+#endif
+    { "TSC",              clockTsc,             -1 },
+};
+
+static chrono_clock_info_t clock_info[chrono_clock_count];
+static bool clock_probed = false;
+static chrono_clock_source_t clock_selected = chrono_clock_monotonic;
+static bool (*clock_now)(chrono_clock_t *) = clockMonotonic;
+
+static bool clockResolution(chrono_clock_source_t source, chrono_t * c)
+{
+    if (source == chrono_clock_tsc) {
+        if (!ChronoTscCalibrate(&clock_tsc, NULL))
+            return false;
+        // 1カウントが1ナノ秒未満の場合は1ナノ秒とする
+        ChronoTscToChrono(&clock_tsc, 1, c);
+        if (c->value == 0)
+            c->value = 1;
+        return true;
+    }
+
+    struct timespec ts;
+    if (clock_getres(clock_table[source].id, &ts) != 0)
+        return false;
+    *c = ChronoInit((intmax_t)ts.tv_sec * -chrono_nanoseconds + ts.tv_nsec, chrono_nanoseconds);
+    return true;
+}
+
+static void clockLatency(chrono_clock_source_t source, chrono_t * c)
+{
+    bool (*now)(chrono_clock_t *) = clock_table[source].now;
+    intmax_t best = INTMAX_MAX;
+    for (int i = 0; i < CHRONO_CLOCK_PROBE_ROUNDS; ++i) {
+        chrono_mno_t start;
+        chrono_clock_t ct;
+        chrono_t diff;
+        ChronoMnoNow(&start);
+        for (int j = 0; j < CHRONO_CLOCK_PROBE_CALLS; ++j)
+            now(&ct);
+        ChronoMnoDiffNow(&start, &diff);
+
+        intmax_t ns = ChronoGet(&diff, chrono_nanoseconds);
+        if (ns < best)
+            best = ns;
+    }
+    *c = ChronoInit(best / CHRONO_CLOCK_PROBE_CALLS, chrono_nanoseconds);
+}
+
+bool ChronoClockProbe(void)
+{
+    for (int i = 0; i < chrono_clock_count; ++i) {
+        chrono_clock_info_t * info = &clock_info[i];
+        info->source = i;
+        info->name = clock_table[i].name;
+        info->resolution = ChronoInit(0, chrono_nanoseconds);
+        info->latency = ChronoInit(0, chrono_nanoseconds);
+
+        chrono_clock_t ct;
+        info->available = clock_table[i].now
+            && clockResolution(i, &info->resolution)
+            && clock_table[i].now(&ct);
+        if (info->available)
+            clockLatency(i, &info->latency);
+    }
+    clock_probed = true;
+    return clock_info[chrono_clock_monotonic].available;
+}
+
+bool ChronoClockInfo(chrono_clock_source_t source, chrono_clock_info_t * info)
+{
+    if (source >= chrono_clock_count)
+        return false;
+    if (!clock_probed)
+        ChronoClockProbe();
+    *info = clock_info[source];
+    return true;
+}
+
+bool ChronoClockSelect(chrono_t const * resolution)
+{
+    if (!clock_probed)
+        ChronoClockProbe();
+
+    intmax_t limit = ChronoGet(resolution, chrono_nanoseconds);
+    int best = -1;
+    for (int i = 0; i < chrono_clock_count; ++i) {
+        chrono_clock_info_t const * info = &clock_info[i];
+        if (!info->available || ChronoGet(&info->resolution, chrono_nanoseconds) > limit)
+            continue;
+        if (best < 0 || info->latency.value < clock_info[best].latency.value)
+            best = i;
+    }
+    if (best < 0)
+        return false;
+
+    clock_selected = best;
+    clock_now = clock_table[best].now;
+    return true;
+}
+
+chrono_clock_source_t ChronoClockSelected(void)
+{
+    return clock_selected;
+}
+
+bool ChronoClockNow(chrono_clock_t * ct)
+{
+    ct->source = clock_selected;
+    return clock_now(ct);
+}
+
+bool ChronoClockDiff(chrono_clock_t const * ct1, chrono_clock_t const * ct2, chrono_t * c)
+{
+    if (ct1->source != ct2->source)
+        return false;
+    switch (ct1->source) {
+#if defined(CLOCK_MONOTONIC_RAW)
+    case chrono_clock_monotonic_raw:
+        return ChronoRawDiff(&ct1->raw, &ct2->raw, c);
+#endif
+#if defined(CLOCK_BOOTTIME)
+    case chrono_clock_boottime:
+        return ChronoBootDiff(&ct1->boot, &ct2->boot, c);
+#endif
+    default:
+        return ChronoMnoDiff(&ct1->mno, &ct2->mno, c);
+    }
+}
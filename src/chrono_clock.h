@@ -0,0 +1,112 @@
+/*! @file
+  Chrono : 時計の性能調査モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  使用可能な時計の分解能と1回あたりの読み出し時間を実測し、
+  要求する分解能を満たす最も速い時計を関数ポインタで選択する.
+  選択した時計の値は、読み出した時計の種類と、その時計の時刻型の組 chrono_clock_t で扱う.
+  時計ごとに起点が異なるため、種類の異なる値どうしは比較できない.
+  ChronoClockProbe() と ChronoClockSelect() は、スレッドを開始する前に呼び出すこと
+*/
+
+#ifndef CHRONO_CLOCK_H
+#define CHRONO_CLOCK_H
+
+#include "chrono_mno.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoClock"
+#endif
+
+#if defined(CLOCK_MONOTONIC_RAW)
+# include "chrono_raw.h"
+#endif
+#if defined(CLOCK_BOOTTIME)
+# include "chrono_boot.h"
+#endif
+
+/*!
+  時計の種類.
+ */
+typedef enum {
+    chrono_clock_monotonic,         //!< CLOCK_MONOTONIC
+    chrono_clock_monotonic_raw,     //!< CLOCK_MONOTONIC_RAW
+    chrono_clock_monotonic_coarse,  //!< CLOCK_MONOTONIC_COARSE
+    chrono_clock_boottime,          //!< CLOCK_BOOTTIME
+    chrono_clock_tsc,               //!< 較正した TSC
+    chrono_clock_count,             //!< 時計の数
+} chrono_clock_source_t;
+
+
+/*!
+  時計の情報.
+ */
+typedef struct {
+    chrono_clock_source_t source;  //!< 時計の種類
+    char const * name;             //!< 時計の名前
+    bool available;                //!< 使用できるか
+    chrono_t resolution;           //!< 分解能
+    chrono_t latency;              //!< 1回あたりの読み出し時間
+} chrono_clock_info_t;
+
+
+/*!
+  選択した時計の時刻.
+  MONOTONIC_RAW は raw, BOOTTIME は boot, それ以外(較正した TSC を含む)は mno に設定される
+ */
+typedef struct {
+    chrono_clock_source_t source;  //!< 読み出した時計
+    union {
+        chrono_mno_t mno;          //!< MONOTONIC, MONOTONIC_COARSE, TSC の時刻
+#if defined(CLOCK_MONOTONIC_RAW)
+        chrono_raw_t raw;          //!< MONOTONIC_RAW の時刻
+#endif
+#if defined(CLOCK_BOOTTIME)
+        chrono_boot_t boot;        //!< BOOTTIME の時刻
+#endif
+    };
+} chrono_clock_t;
+
+
+/*!
+  すべての時計の分解能と読み出し時間を測定する.
+ */
+extern bool ChronoClockProbe(void);
+
+
+/*!
+  時計 source の情報を info に設定する.
+  測定していない場合は、先に測定する
+ */
+extern bool ChronoClockInfo(chrono_clock_source_t source, chrono_clock_info_t * info);
+
+
+/*!
+  分解能が resolution 以下の時計のうち、最も速い時計を選択する.
+  該当する時計がない場合は false を返し、選択を変更しない
+ */
+extern bool ChronoClockSelect(chrono_t const * resolution);
+
+
+/*!
+  選択している時計を返す. 初期値は chrono_clock_monotonic
+ */
+extern chrono_clock_source_t ChronoClockSelected(void);
+
+
+/*!
+  選択している時計の現在時刻を ct に設定する.
+ */
+extern bool ChronoClockNow(chrono_clock_t * ct);
+
+
+/*!
+  時刻 ct1 - ct2 間の時間差(絶対値)を c に設定する.
+  読み出した時計が異なる場合は false を返す
+ */
+extern bool ChronoClockDiff(chrono_clock_t const * ct1, chrono_clock_t const * ct2, chrono_t * c);
+
+#endif // CHRONO_CLOCK_H
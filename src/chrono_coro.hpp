@@ -0,0 +1,262 @@
+/*! @file
+  Chrono : C++20 コルーチン用の待機
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  シングルスレッドの実行器で、co_await できる sleep_for / sleep_until を提供する.
+  待機中のコルーチンは期限順のヒープに積み、先頭の期限に合わせた timerfd を epoll で 1 つだけ待つ.
+  待機中のコルーチンはフレームとヒープの要素だけを消費し、スレッドは消費しない.
+
+  @code
+  Chrono::executor ex;
+  ex.spawn([](Chrono::executor & ex) -> Chrono::task {
+      co_await ex.sleep_for(Chrono::milliseconds(10));
+  }(ex));
+  ex.run();
+  @endcode
+*/
+
+#ifndef CHRONO_CORO_HPP
+#define CHRONO_CORO_HPP
+
+#include "chrono.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <system_error>
+#include <vector>
+
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace Chrono {
+
+class executor;
+
+/*!
+  実行器で動かすコルーチン. 結果を返さず、完了するとフレームは自動で解放される
+ */
+class task {
+public:
+    struct promise_type {
+        executor * exec = nullptr;
+
+        ~promise_type();
+        task get_return_object() noexcept { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    task(task && t) noexcept
+        : h_(t.h_) { t.h_ = nullptr; }
+
+    task & operator=(task &&) = delete;
+
+    ~task()
+    {
+        if (h_)
+            h_.destroy();
+    }
+
+private:
+    friend class executor;
+
+    explicit task(std::coroutine_handle<promise_type> h) noexcept
+        : h_(h) {}
+
+    std::coroutine_handle<promise_type> h_;
+};
+
+
+/*!
+  シングルスレッドの実行器.
+ */
+class executor {
+public:
+    executor()
+    {
+        epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        tfd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        if (epfd_ < 0 || tfd_ < 0 || ::epoll_ctl(epfd_, EPOLL_CTL_ADD, tfd_, &ev) != 0) {
+            int e = errno;
+            close();
+            throw std::system_error(e, std::system_category(), "Chrono::executor");
+        }
+    }
+
+    executor(executor const &) = delete;
+    executor & operator=(executor const &) = delete;
+
+    ~executor()
+    {
+        // 待機中のコルーチンを破棄する
+        while (!timers_.empty()) {
+            timers_.top().h.destroy();
+            timers_.pop();
+        }
+        for (auto h : ready_)
+            h.destroy();
+        close();
+    }
+
+    //! コルーチン t を実行待ちに加える
+    void spawn(task t)
+    {
+        auto h = t.h_;
+        t.h_ = nullptr;
+        h.promise().exec = this;
+        ++live_;
+        ready_.push_back(h);
+    }
+
+    //! すべてのコルーチンが完了するまで実行する
+    void run()
+    {
+        for (;;) {
+            while (!ready_.empty()) {
+                auto h = ready_.front();
+                ready_.pop_front();
+                h.resume();
+            }
+            if (timers_.empty())
+                break;
+
+            std::int64_t now = clock_now();
+            if (timers_.top().deadline > now) {
+                wait(timers_.top().deadline);
+                now = clock_now();
+            }
+            while (!timers_.empty() && timers_.top().deadline <= now) {
+                ready_.push_back(timers_.top().h);
+                timers_.pop();
+            }
+        }
+    }
+
+    //! 未完了のコルーチン数
+    std::size_t size() const noexcept { return live_; }
+
+    //! epoll_wait で起床した回数
+    std::uint64_t wakeups() const noexcept { return wakeups_; }
+
+    /*!
+      co_await で期限まで待つ待機.
+     */
+    struct sleep_awaiter {
+        executor & exec;
+        std::int64_t deadline;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) { exec.timers_.push(timer{ deadline, exec.seq_++, h }); }
+        void await_resume() const noexcept {}
+    };
+
+    //! モノトニック時刻 tp まで待つ
+    sleep_awaiter sleep_until(mno_time tp) noexcept
+    {
+        return sleep_awaiter{ *this, tp.time_since_epoch().count() };
+    }
+
+    //! モノトニック時刻 cm まで待つ
+    sleep_awaiter sleep_until(chrono_mno_t const & cm) noexcept
+    {
+        return sleep_until(mno_time(cm));
+    }
+
+    //! 期間 d だけ待つ
+    template <class P>
+    sleep_awaiter sleep_for(duration<P> const & d) noexcept
+    {
+        return sleep_awaiter{ *this, clock_now() + nanoseconds(d).count() };
+    }
+
+    //! 期間 d だけ待つ
+    template <class R, class P>
+    sleep_awaiter sleep_for(std::chrono::duration<R, P> const & d) noexcept
+    {
+        return sleep_awaiter{ *this, clock_now() + std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() };
+    }
+
+    //! 期間 c だけ待つ
+    sleep_awaiter sleep_for(chrono_t const & c) noexcept
+    {
+        return sleep_awaiter{ *this, clock_now() + ChronoGet(&c, chrono_nanoseconds) };
+    }
+
+private:
+    friend struct task::promise_type;
+
+    struct timer {
+        std::int64_t deadline;
+        std::uint64_t seq;  // 同じ期限は登録順
+        std::coroutine_handle<> h;
+
+        bool operator>(timer const & rhs) const noexcept
+        {
+            return deadline > rhs.deadline || (deadline == rhs.deadline && seq > rhs.seq);
+        }
+    };
+
+    static std::int64_t clock_now() noexcept
+    {
+        return mno_time::now().time_since_epoch().count();
+    }
+
+    void wait(std::int64_t deadline)
+    {
+        if (deadline != armed_) {
+            itimerspec its{};
+            its.it_value.tv_sec = deadline / 1000000000;
+            its.it_value.tv_nsec = deadline % 1000000000;
+            ::timerfd_settime(tfd_, TFD_TIMER_ABSTIME, &its, nullptr);
+            armed_ = deadline;
+        }
+        epoll_event ev;
+        while (::epoll_wait(epfd_, &ev, 1, -1) < 0 && errno == EINTR)
+            ;
+        std::uint64_t expirations;
+        if (::read(tfd_, &expirations, sizeof(expirations)) > 0)
+            armed_ = 0;
+        ++wakeups_;
+    }
+
+    void close() noexcept
+    {
+        if (tfd_ >= 0)
+            ::close(tfd_);
+        if (epfd_ >= 0)
+            ::close(epfd_);
+        tfd_ = epfd_ = -1;
+    }
+
+    int epfd_ = -1;
+    int tfd_ = -1;
+    std::int64_t armed_ = 0;
+    std::uint64_t seq_ = 0;
+    std::uint64_t wakeups_ = 0;
+    std::size_t live_ = 0;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<timer, std::vector<timer>, std::greater<timer>> timers_;
+};
+
+inline task::promise_type::~promise_type()
+{
+    if (exec)
+        --exec->live_;
+}
+
+}  // namespace Chrono
+
+#endif // CHRONO_CORO_HPP
@@ -0,0 +1,282 @@
+/*! @file
+  Chrono : cron 式の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_cron.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/*!
+  何年先まで探すか. 2月29日は最大 8 年に 1 度
+ */
+#define CRON_YEARS 9
+
+static char const * const cronMonths[] = { "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC" };
+static char const * const cronWeekdays[] = { "SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT" };
+
+static bool cronNumber(char const ** p, char const * const * names, int count, int first, int * v)
+{
+    char const * s = *p;
+    if (isdigit((unsigned char)*s)) {
+        char * end;
+        long n = strtol(s, &end, 10);
+        if (n > 1000)
+            return false;
+        *v = (int)n;
+        *p = end;
+        return true;
+    }
+    if (names && isalpha((unsigned char)*s)) {
+        for (int i = 0; i < count; ++i) {
+            if (strncasecmp(s, names[i], 3) == 0 && !isalpha((unsigned char)s[3])) {
+                *v = first + i;
+                *p = s + 3;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*!
+  1 項目を [lo, hi] のビット集合 bits に変換する. * なら any を真にする
+ */
+static bool cronField(char const ** p, int lo, int hi, char const * const * names, int count, uint64_t * bits, bool * any)
+{
+    char const * s = *p;
+    *bits = 0;
+    if (any)
+        *any = (*s == '*');
+
+    for (;;) {
+        int a, b, step = 1;
+        if (*s == '*') {
+            a = lo;
+            b = hi;
+            ++s;
+        } else {
+            if (!cronNumber(&s, names, count, lo, &a))
+                return false;
+            b = a;
+            if (*s == '-') {
+                ++s;
+                if (!cronNumber(&s, names, count, lo, &b))
+                    return false;
+            }
+        }
+        if (*s == '/') {
+            ++s;
+            if (!cronNumber(&s, NULL, 0, 0, &step) || step <= 0)
+                return false;
+            if (a == b && b != hi)  // a/n は a-最大/n
+                b = hi;
+        }
+        if (a < lo || b > hi || a > b)
+            return false;
+        for (int i = a; i <= b; i += step)
+            *bits |= (uint64_t)1 << i;
+
+        if (*s != ',')
+            break;
+        ++s;
+    }
+    if (*s && !isspace((unsigned char)*s))
+        return false;
+    while (isspace((unsigned char)*s))
+        ++s;
+    *p = s;
+    return true;
+}
+
+static char const * cronMacro(char const * expr)
+{
+    static char const * const macros[][2] = {
+        { "@yearly", "0 0 1 1 *" }, { "@annually", "0 0 1 1 *" }, { "@monthly", "0 0 1 * *" },
+        { "@weekly", "0 0 * * 0" }, { "@daily", "0 0 * * *" }, { "@midnight", "0 0 * * *" },
+        { "@hourly", "0 * * * *" },
+    };
+    for (size_t i = 0; i < sizeof(macros) / sizeof(macros[0]); ++i)
+        if (strcmp(expr, macros[i][0]) == 0)
+            return macros[i][1];
+    return expr;
+}
+
+bool ChronoCronParse(chrono_cron_t * cron, char const * expr)
+{
+    uint64_t bits;
+    char const * s = cronMacro(expr);
+    while (isspace((unsigned char)*s))
+        ++s;
+
+    if (!cronField(&s, 0, 59, NULL, 0, &bits, NULL))
+        return false;
+    cron->minute = bits;
+    if (!cronField(&s, 0, 23, NULL, 0, &bits, NULL))
+        return false;
+    cron->hour = (uint32_t)bits;
+    if (!cronField(&s, 1, 31, NULL, 0, &bits, &cron->mday_any))
+        return false;
+    cron->mday = (uint32_t)bits;
+    if (!cronField(&s, 1, 12, cronMonths, 12, &bits, NULL))
+        return false;
+    cron->month = (uint16_t)bits;
+    if (!cronField(&s, 0, 7, cronWeekdays, 7, &bits, &cron->wday_any))
+        return false;
+    cron->wday = (uint8_t)((bits | (bits >> 7)) & 0x7f);  // 7 は日曜日
+    return *s == '\0';
+}
+
+/*
+ * 暦の計算 (1970-01-01 からの日数と年月日の相互変換)
+ */
+
+static int64_t cronDaysFromCivil(int64_t y, int m, int d)
+{
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void cronCivilFromDays(int64_t z, int64_t * y, int * m, int * d)
+{
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    *d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+static int cronDaysInMonth(int64_t y, int m)
+{
+    static int const days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (m == 2 && (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)))
+        return 29;
+    return days[m - 1];
+}
+
+/*!
+  1970-01-01 からの日数 z の曜日 (0 が日曜日).
+ */
+static int cronWeekday(int64_t z)
+{
+    return (int)(z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6);
+}
+
+/*!
+  from 以上で最初に立っているビット. なければ -1
+ */
+static inline int cronScan(uint64_t bits, int from)
+{
+    if (from >= 64)
+        return -1;
+    bits &= ~(uint64_t)0 << from;
+    return bits ? __builtin_ctzll(bits) : -1;
+}
+
+/*!
+  y 年 m 月で発火する日のビット集合 (ビット 1 - 31).
+ */
+static uint32_t cronDays(chrono_cron_t const * cron, int64_t y, int m)
+{
+    uint32_t month = (uint32_t)(((uint64_t)1 << (cronDaysInMonth(y, m) + 1)) - 2);
+    if (cron->mday_any && cron->wday_any)
+        return month;
+
+    // 1 日の曜日から始まるように曜日のビットを回し、7 日周期で並べる
+    int w1 = cronWeekday(cronDaysFromCivil(y, m, 1));
+    uint32_t p = ((uint32_t)cron->wday >> w1 | (uint32_t)cron->wday << (7 - w1)) & 0x7f;
+    uint32_t wdays = (p | p << 7 | p << 14 | p << 21 | p << 28) << 1;
+
+    uint32_t days;
+    if (cron->mday_any)
+        days = wdays;
+    else if (cron->wday_any)
+        days = cron->mday;
+    else
+        days = cron->mday | wdays;
+    return days & month;
+}
+
+bool ChronoCronMatch(chrono_cron_t const * cron, chrono_sys_t const * tp)
+{
+    int64_t t = tp->time_point.tv_sec;
+    int64_t days = (t >= 0 ? t : t - 86399) / 86400;
+    int64_t sec = t - days * 86400;
+    int64_t y;
+    int m, d;
+    cronCivilFromDays(days, &y, &m, &d);
+    return (cron->minute >> (sec / 60 % 60) & 1) && (cron->hour >> (sec / 3600) & 1)
+        && (cron->month >> m & 1) && (cronDays(cron, y, m) >> d & 1);
+}
+
+bool ChronoCronNext(chrono_cron_t const * cron, chrono_sys_t const * after, chrono_sys_t * next)
+{
+    // after の次の分から探す
+    int64_t t = after->time_point.tv_sec;
+    int64_t minutes = (t >= 0 ? t : t - 59) / 60 + 1;
+    int64_t days = (minutes >= 0 ? minutes : minutes - 1439) / 1440;
+    int hm = (int)(minutes - days * 1440);
+    int H = hm / 60, M = hm % 60;
+    int64_t y;
+    int m, d;
+    cronCivilFromDays(days, &y, &m, &d);
+    int64_t limit = y + CRON_YEARS;
+
+    while (y <= limit) {
+        int nm = cronScan(cron->month, m);
+        if (nm < 0) {
+            ++y;
+            m = 1; d = 1; H = 0; M = 0;
+            continue;
+        }
+        if (nm != m) {
+            m = nm; d = 1; H = 0; M = 0;
+        }
+
+        int nd = cronScan(cronDays(cron, y, m), d);
+        if (nd < 0) {
+            if (++m > 12) {
+                ++y;
+                m = 1;
+            }
+            d = 1; H = 0; M = 0;
+            continue;
+        }
+        if (nd != d) {
+            d = nd; H = 0; M = 0;
+        }
+
+        int nh = cronScan(cron->hour, H);
+        if (nh < 0) {
+            ++d; H = 0; M = 0;
+            continue;
+        }
+        if (nh != H) {
+            H = nh; M = 0;
+        }
+
+        int nmin = cronScan(cron->minute, M);
+        if (nmin < 0) {
+            ++H; M = 0;
+            continue;
+        }
+
+        next->time_point.tv_sec = (time_t)(cronDaysFromCivil(y, m, d) * 86400 + H * 3600 + nmin * 60);
+        next->time_point.tv_nsec = 0;
+        return true;
+    }
+    return false;
+}
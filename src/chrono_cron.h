@@ -0,0 +1,60 @@
+/*! @file
+  Chrono : cron 式モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  cron 式 "分 時 日 月 曜日" を、各項目のビット集合に変換しておき、
+  次に発火するシステム時刻(UTC)をビット走査で求める.
+  暦の計算は整数演算で行い、gmtime / mktime は使わない.
+
+  各項目には *, 数値, 範囲 a-b, 間隔 * / n と a-b / n, それらのリスト a,b,c を書ける.
+  月と曜日は JAN - DEC, SUN - SAT の名前も使える. 曜日の 7 は日曜日.
+  日と曜日の両方を指定した場合は、どちらかに一致すれば発火する.
+  @yearly, @monthly, @weekly, @daily, @hourly も使える
+*/
+
+#ifndef CHRONO_CRON_H
+#define CHRONO_CRON_H
+
+#include "chrono_sys.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoCron"
+#endif
+
+/*!
+  コンパイル済みの cron 式.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    uint64_t minute;  //!< 分 (ビット 0 - 59)
+    uint32_t hour;    //!< 時 (ビット 0 - 23)
+    uint32_t mday;    //!< 日 (ビット 1 - 31)
+    uint16_t month;   //!< 月 (ビット 1 - 12)
+    uint8_t wday;     //!< 曜日 (ビット 0 - 6, 0 が日曜日)
+    bool mday_any;    //!< 日が * か
+    bool wday_any;    //!< 曜日が * か
+} chrono_cron_t;
+
+
+/*!
+  cron 式 expr を cron に変換する. 構文が誤っている場合は false を返す
+ */
+extern bool ChronoCronParse(chrono_cron_t * cron, char const * expr);
+
+
+/*!
+  システム時刻 tp (分単位) が cron に一致すると true を返す.
+ */
+extern bool ChronoCronMatch(chrono_cron_t const * cron, chrono_sys_t const * tp);
+
+
+/*!
+  システム時刻 after より後で、cron に一致する最初の時刻を next に設定する.
+  一致する時刻がない場合 (2月30日など) は false を返す
+ */
+extern bool ChronoCronNext(chrono_cron_t const * cron, chrono_sys_t const * after, chrono_sys_t * next);
+
+#endif // CHRONO_CRON_H
@@ -0,0 +1,29 @@
+/*! @file
+  Chrono : 待機期限の内部モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  期間で指定された待機を、モノトニック時刻の期限での待機に置き換えるための補助.
+  chrono_futex.c と chrono_pthread.c の内部で使う
+*/
+
+#ifndef CHRONO_DEADLINE_H
+#define CHRONO_DEADLINE_H
+
+#include "chrono_mno.h"
+
+/*!
+  期間 timeout 後のモノトニック時刻を deadline に設定する. timeout が NULL なら NULL を返す
+ */
+static inline chrono_mno_t const * ChronoDeadlineAfter(chrono_t const * timeout, chrono_mno_t * deadline)
+{
+    if (timeout == NULL)
+        return NULL;
+    ChronoMnoNow(deadline);
+    ChronoMnoAdd(deadline, timeout);
+    return deadline;
+}
+
+#endif // CHRONO_DEADLINE_H
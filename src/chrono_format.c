@@ -0,0 +1,205 @@
+/*! @file
+  Chrono : 期間の文字列化の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_format.h"
+#include <string.h>
+
+#define FORMAT_NS_PER_SEC 1000000000ULL
+#define FORMAT_NS_PER_MIN (60 * FORMAT_NS_PER_SEC)
+#define FORMAT_NS_PER_HOUR (3600 * FORMAT_NS_PER_SEC)
+
+static char const formatPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static int formatWidth(uint64_t v)
+{
+    int n = 1;
+    for (uint64_t p = 10; n < 20 && v >= p; p *= 10)
+        ++n;
+    return n;
+}
+
+/*!
+  v を 0 埋めで width 桁書き込み、末尾を返す. 下の桁から 2 桁ずつ埋める
+ */
+static char * formatPad(char * p, uint64_t v, int width)
+{
+    char * q = p + width;
+    while (q - p >= 2) {
+        q -= 2;
+        memcpy(q, &formatPairs[(v % 100) * 2], 2);
+        v /= 100;
+    }
+    if (q > p)
+        *p = (char)('0' + v % 10);
+    return p + width;
+}
+
+static char * formatUint(char * p, uint64_t v)
+{
+    return formatPad(p, v, formatWidth(v));
+}
+
+/*!
+  小数部 frac (width 桁) を precision 桁で切り捨てて書き込む. 末尾の 0 は省き、すべて 0 なら小数点も省く
+ */
+static char * formatFraction(char * p, uint64_t frac, int width, int precision)
+{
+    if (precision <= 0 || frac == 0)
+        return p;
+    char * q = formatPad(p + 1, frac, width);
+    char * end = p + 1 + ((precision < width) ? precision : width);
+    if (end > q)
+        end = q;
+    while (end > p + 1 && end[-1] == '0')
+        --end;
+    if (end == p + 1)
+        return p;
+    *p = '.';
+    return end;
+}
+
+static char * formatUnit(char * p, char const * unit)
+{
+    size_t n = strlen(unit);
+    memcpy(p, unit, n);
+    return p + n;
+}
+
+/*!
+  ナノ秒の絶対値 ns を単位 unit (1 単位のナノ秒 scale) で書き込む.
+ */
+static char * formatFixed(char * p, uint64_t ns, uint64_t scale, char const * unit, int precision)
+{
+    uint64_t whole = ns / scale;
+    uint64_t rest = ns - whole * scale;
+    p = formatUint(p, whole);
+    switch (scale) {
+    case 1:
+        break;
+    case 1000:
+        p = formatFraction(p, rest, 3, precision);
+        break;
+    case 1000000:
+        p = formatFraction(p, rest, 6, precision);
+        break;
+    case FORMAT_NS_PER_SEC:
+        p = formatFraction(p, rest, 9, precision);
+        break;
+    default:
+        // 分, 時, 日は 10 進の桁に揃わないので、小数部を 9 桁に換算する
+        p = formatFraction(p, (uint64_t)((unsigned __int128)rest * FORMAT_NS_PER_SEC / scale), 9, precision);
+        break;
+    }
+    return formatUnit(p, unit);
+}
+
+static size_t formatCopy(char const * s, size_t n, char * buf, size_t size)
+{
+    if (size > 0) {
+        size_t m = (n < size) ? n : size - 1;
+        memcpy(buf, s, m);
+        buf[m] = '\0';
+    }
+    return n;
+}
+
+/*!
+  期間 c の符号を書き込み、ナノ秒の絶対値を返す.
+ */
+static uint64_t formatSign(chrono_t const * c, char ** p)
+{
+    intmax_t ns = ChronoGet(c, chrono_nanoseconds);
+    if (ns >= 0)
+        return (uint64_t)ns;
+    *(*p)++ = '-';
+    return (uint64_t)0 - (uint64_t)ns;
+}
+
+size_t ChronoFormat(chrono_t const * c, char * buf, size_t size, int precision)
+{
+    char tmp[CHRONO_FORMAT_MAX];
+    char * p = tmp;
+    uint64_t ns = formatSign(c, &p);
+
+    if (ns == 0) {
+        p = tmp;
+        *p++ = '0';
+        *p++ = 's';
+    } else if (ns >= FORMAT_NS_PER_MIN) {
+        uint64_t h = ns / FORMAT_NS_PER_HOUR;
+        uint64_t rest = ns - h * FORMAT_NS_PER_HOUR;
+        uint64_t m = rest / FORMAT_NS_PER_MIN;
+        rest -= m * FORMAT_NS_PER_MIN;
+        uint64_t s = rest / FORMAT_NS_PER_SEC;
+        rest -= s * FORMAT_NS_PER_SEC;
+        if (h) {
+            p = formatUint(p, h);
+            *p++ = 'h';
+            p = formatPad(p, m, 2);
+        } else {
+            p = formatUint(p, m);
+        }
+        *p++ = 'm';
+        p = formatPad(p, s, 2);
+        p = formatFraction(p, rest, 9, precision);
+        *p++ = 's';
+    } else if (ns >= FORMAT_NS_PER_SEC) {
+        p = formatFixed(p, ns, FORMAT_NS_PER_SEC, "s", precision);
+    } else if (ns >= 1000000) {
+        p = formatFixed(p, ns, 1000000, "ms", precision);
+    } else if (ns >= 1000) {
+        p = formatFixed(p, ns, 1000, "\xc2\xb5s", precision);
+    } else {
+        p = formatFixed(p, ns, 1, "ns", precision);
+    }
+    return formatCopy(tmp, (size_t)(p - tmp), buf, size);
+}
+
+size_t ChronoFormatUnit(chrono_t const * c, chrono_period_t unit, char * buf, size_t size, int precision)
+{
+    char tmp[CHRONO_FORMAT_MAX];
+    char * p = tmp;
+    uint64_t ns = formatSign(c, &p);
+
+    switch (unit) {
+    case chrono_days:
+        p = formatFixed(p, ns, 24 * FORMAT_NS_PER_HOUR, "d", precision);
+        break;
+    case chrono_hours:
+        p = formatFixed(p, ns, FORMAT_NS_PER_HOUR, "h", precision);
+        break;
+    case chrono_minutes:
+        p = formatFixed(p, ns, FORMAT_NS_PER_MIN, "m", precision);
+        break;
+    case chrono_seconds:
+        p = formatFixed(p, ns, FORMAT_NS_PER_SEC, "s", precision);
+        break;
+    case chrono_milliseconds:
+        p = formatFixed(p, ns, 1000000, "ms", precision);
+        break;
+    case chrono_microseconds:
+        p = formatFixed(p, ns, 1000, "\xc2\xb5s", precision);
+        break;
+    case chrono_nanoseconds:
+        p = formatFixed(p, ns, 1, "ns", precision);
+        break;
+    default:
+        return formatCopy("", 0, buf, size);
+    }
+    return formatCopy(tmp, (size_t)(p - tmp), buf, size);
+}
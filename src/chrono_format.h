@@ -0,0 +1,40 @@
+/*! @file
+  Chrono : 期間の文字列化モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  期間を "1h02m03.004s" や "850µs" のような文字列にする.
+  2 桁ずつの数字表で数字を並べ、ロケールやメモリ確保を使わない.
+  小数部は precision 桁で切り捨て、末尾の 0 は省く.
+  期間はナノ秒に変換して扱うため、およそ ±292 年を超える期間は表せない
+*/
+
+#ifndef CHRONO_FORMAT_H
+#define CHRONO_FORMAT_H
+
+#include "chrono.h"
+#include <stddef.h>
+
+/*!
+  出力に必要な最大の大きさ(終端文字を含む).
+ */
+#define CHRONO_FORMAT_MAX 32
+
+
+/*!
+  期間 c を単位を自動で選んで文字列にし、buf (大きさ size) に書き込む.
+  1 分以上は "1h02m03.004s" の形、1 分未満は s, ms, µs, ns のうち整数部が 1 以上になる最大の単位を使う.
+  snprintf と同じく、終端文字を除いた文字数を返し、size が足りなければ切り詰める
+ */
+extern size_t ChronoFormat(chrono_t const * c, char * buf, size_t size, int precision);
+
+
+/*!
+  期間 c を単位 unit (d, h, m, s, ms, µs, ns) で文字列にし、buf (大きさ size) に書き込む.
+  unit が chrono_period_t のいずれでもない場合は、空文字列を書き込んで 0 を返す
+ */
+extern size_t ChronoFormatUnit(chrono_t const * c, chrono_period_t unit, char * buf, size_t size, int precision);
+
+#endif // CHRONO_FORMAT_H
@@ -0,0 +1,182 @@
+/*! @file
+  Chrono : futex 待機の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_futex.h"
+#include "chrono_deadline.h"
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int ChronoFutexWait(_Atomic uint32_t * word, uint32_t expected, chrono_mno_t const * deadline)
+{
+    struct timespec ts;
+    if (deadline)
+        ChronoMnoToTimeSpec(deadline, &ts);
+    // FUTEX_CLOCK_REALTIME を付けなければ、絶対時刻は CLOCK_MONOTONIC で解釈される
+    long r = syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, expected,
+                     deadline ? &ts : NULL, NULL, FUTEX_BITSET_MATCH_ANY);
+    if (r == 0 || errno == EAGAIN)
+        return 0;
+    return errno;
+}
+
+int ChronoFutexWaitFor(_Atomic uint32_t * word, uint32_t expected, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    return ChronoFutexWait(word, expected, ChronoDeadlineAfter(timeout, &deadline));
+}
+
+int ChronoFutexWake(_Atomic uint32_t * word, int n)
+{
+    long r = syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, n, NULL, NULL, 0);
+    return (r < 0) ? 0 : (int)r;
+}
+
+int ChronoFutexWakeAll(_Atomic uint32_t * word)
+{
+    return ChronoFutexWake(word, INT_MAX);
+}
+
+void ChronoEventInit(chrono_event_t * ev, bool set)
+{
+    atomic_init(&ev->state, set ? 1 : 0);
+}
+
+void ChronoEventSet(chrono_event_t * ev)
+{
+    if (atomic_exchange(&ev->state, 1) == 2)
+        ChronoFutexWakeAll(&ev->state);
+}
+
+void ChronoEventReset(chrono_event_t * ev)
+{
+    uint32_t set = 1;
+    atomic_compare_exchange_strong(&ev->state, &set, 0);
+}
+
+bool ChronoEventIsSet(chrono_event_t const * ev)
+{
+    return atomic_load((_Atomic uint32_t *)&ev->state) == 1;
+}
+
+bool ChronoEventWait(chrono_event_t * ev, chrono_mno_t const * deadline)
+{
+    for (;;) {
+        uint32_t s = atomic_load(&ev->state);
+        if (s == 1)
+            return true;
+        if (s == 0 && !atomic_compare_exchange_weak(&ev->state, &s, 2))
+            continue;
+        int r = ChronoFutexWait(&ev->state, 2, deadline);
+        if (r == ETIMEDOUT)
+            return atomic_load(&ev->state) == 1;
+        if (r != 0 && r != EINTR)  // 期限が不正な場合など
+            return false;
+    }
+}
+
+bool ChronoEventWaitFor(chrono_event_t * ev, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    if (ChronoEventIsSet(ev))
+        return true;
+    return ChronoEventWait(ev, ChronoDeadlineAfter(timeout, &deadline));
+}
+
+void ChronoSemInit(chrono_sem_t * sem, uint32_t count)
+{
+    atomic_init(&sem->count, count);
+    atomic_init(&sem->waiters, 0);
+}
+
+void ChronoSemPost(chrono_sem_t * sem)
+{
+    atomic_fetch_add(&sem->count, 1);
+    if (atomic_load(&sem->waiters) > 0)
+        ChronoFutexWake(&sem->count, 1);
+}
+
+bool ChronoSemTryWait(chrono_sem_t * sem)
+{
+    uint32_t c = atomic_load(&sem->count);
+    while (c > 0)
+        if (atomic_compare_exchange_weak(&sem->count, &c, c - 1))
+            return true;
+    return false;
+}
+
+bool ChronoSemWait(chrono_sem_t * sem, chrono_mno_t const * deadline)
+{
+    for (;;) {
+        if (ChronoSemTryWait(sem))
+            return true;
+        atomic_fetch_add(&sem->waiters, 1);
+        int r = ChronoFutexWait(&sem->count, 0, deadline);
+        atomic_fetch_sub(&sem->waiters, 1);
+        if (r == ETIMEDOUT)
+            return ChronoSemTryWait(sem);
+        if (r != 0 && r != EINTR)
+            return false;
+    }
+}
+
+bool ChronoSemWaitFor(chrono_sem_t * sem, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    if (ChronoSemTryWait(sem))
+        return true;
+    return ChronoSemWait(sem, ChronoDeadlineAfter(timeout, &deadline));
+}
+
+void ChronoLatchInit(chrono_latch_t * latch, uint32_t count)
+{
+    atomic_init(&latch->count, count);
+}
+
+void ChronoLatchCountDown(chrono_latch_t * latch, uint32_t n)
+{
+    uint32_t c = atomic_load(&latch->count);
+    uint32_t next;
+    do {
+        if (c == 0)
+            return;
+        // 計数を超えて減らしても 0 で止める
+        next = (n < c) ? c - n : 0;
+    } while (!atomic_compare_exchange_weak(&latch->count, &c, next));
+    if (next == 0)
+        ChronoFutexWakeAll(&latch->count);
+}
+
+bool ChronoLatchTryWait(chrono_latch_t const * latch)
+{
+    return atomic_load((_Atomic uint32_t *)&latch->count) == 0;
+}
+
+bool ChronoLatchWait(chrono_latch_t * latch, chrono_mno_t const * deadline)
+{
+    for (;;) {
+        uint32_t c = atomic_load(&latch->count);
+        if (c == 0)
+            return true;
+        int r = ChronoFutexWait(&latch->count, c, deadline);
+        if (r == ETIMEDOUT)
+            return atomic_load(&latch->count) == 0;
+        if (r != 0 && r != EINTR)
+            return false;
+    }
+}
+
+bool ChronoLatchWaitFor(chrono_latch_t * latch, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    if (ChronoLatchTryWait(latch))
+        return true;
+    return ChronoLatchWait(latch, ChronoDeadlineAfter(timeout, &deadline));
+}
@@ -0,0 +1,172 @@
+/*! @file
+  Chrono : futex 待機モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  32 ビットの値を FUTEX_WAIT_BITSET で待つ. 期限はモノトニック時刻の絶対時刻で渡すので、
+  システム時刻が変更されても待ち時間がずれず、ChronoSys への変換も要らない.
+  その上にイベント、セマフォ、ラッチを実装する.
+  期限に NULL を渡すと、無期限に待つ
+*/
+
+#ifndef CHRONO_FUTEX_H
+#define CHRONO_FUTEX_H
+
+#include "chrono_mno.h"
+#include <stdatomic.h>
+
+#if !defined(__linux__) || defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoFutex"
+#endif
+
+/*!
+  値 word が expected の間、起こされるか期限 deadline まで待つ.
+  起こされたか、値が expected でなかった場合は 0, 期限を過ぎた場合は ETIMEDOUT, シグナルで中断した場合は EINTR を返す
+ */
+extern int ChronoFutexWait(_Atomic uint32_t * word, uint32_t expected, chrono_mno_t const * deadline);
+
+
+/*!
+  値 word が expected の間、起こされるか期間 timeout だけ待つ.
+ */
+extern int ChronoFutexWaitFor(_Atomic uint32_t * word, uint32_t expected, chrono_t const * timeout);
+
+
+/*!
+  値 word を待つスレッドを最大 n 個起こし、起こした数を返す.
+ */
+extern int ChronoFutexWake(_Atomic uint32_t * word, int n);
+
+
+/*!
+  値 word を待つスレッドをすべて起こし、起こした数を返す.
+ */
+extern int ChronoFutexWakeAll(_Atomic uint32_t * word);
+
+
+/*!
+  イベント. セットされるまで待機する
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic uint32_t state;  //!< 0: 未セット, 1: セット, 2: 未セットで待機スレッドあり
+} chrono_event_t;
+
+
+/*!
+  イベント ev を初期化する.
+ */
+extern void ChronoEventInit(chrono_event_t * ev, bool set);
+
+
+/*!
+  イベント ev をセットし、待機しているスレッドをすべて起こす.
+ */
+extern void ChronoEventSet(chrono_event_t * ev);
+
+
+/*!
+  イベント ev を未セットに戻す.
+ */
+extern void ChronoEventReset(chrono_event_t * ev);
+
+
+/*!
+  イベント ev がセットされていると true を返す.
+ */
+extern bool ChronoEventIsSet(chrono_event_t const * ev);
+
+
+/*!
+  イベント ev がセットされるまで、期限 deadline まで待つ. 期限を過ぎた場合や期限が不正な場合は false を返す
+ */
+extern bool ChronoEventWait(chrono_event_t * ev, chrono_mno_t const * deadline);
+
+
+/*!
+  イベント ev がセットされるまで、期間 timeout だけ待つ. 期限を過ぎた場合は false を返す
+ */
+extern bool ChronoEventWaitFor(chrono_event_t * ev, chrono_t const * timeout);
+
+
+/*!
+  計数セマフォ.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic uint32_t count;    //!< 残数
+    _Atomic uint32_t waiters;  //!< 待機スレッド数
+} chrono_sem_t;
+
+
+/*!
+  セマフォ sem を残数 count で初期化する.
+ */
+extern void ChronoSemInit(chrono_sem_t * sem, uint32_t count);
+
+
+/*!
+  セマフォ sem の残数を 1 増やし、待機スレッドがいれば 1 つ起こす.
+ */
+extern void ChronoSemPost(chrono_sem_t * sem);
+
+
+/*!
+  セマフォ sem の残数が 1 以上なら減らして true を返す. 待たない
+ */
+extern bool ChronoSemTryWait(chrono_sem_t * sem);
+
+
+/*!
+  セマフォ sem の残数を減らせるまで、期限 deadline まで待つ. 期限を過ぎた場合や期限が不正な場合は false を返す
+ */
+extern bool ChronoSemWait(chrono_sem_t * sem, chrono_mno_t const * deadline);
+
+
+/*!
+  セマフォ sem の残数を減らせるまで、期間 timeout だけ待つ. 期限を過ぎた場合は false を返す
+ */
+extern bool ChronoSemWaitFor(chrono_sem_t * sem, chrono_t const * timeout);
+
+
+/*!
+  ラッチ. 計数が 0 になるまで待機する
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic uint32_t count;  //!< 残りの計数
+} chrono_latch_t;
+
+
+/*!
+  ラッチ latch を計数 count で初期化する.
+ */
+extern void ChronoLatchInit(chrono_latch_t * latch, uint32_t count);
+
+
+/*!
+  ラッチ latch の計数を n 減らし、0 になったら待機スレッドをすべて起こす. 計数は 0 より小さくならない.
+ */
+extern void ChronoLatchCountDown(chrono_latch_t * latch, uint32_t n);
+
+
+/*!
+  ラッチ latch の計数が 0 なら true を返す.
+ */
+extern bool ChronoLatchTryWait(chrono_latch_t const * latch);
+
+
+/*!
+  ラッチ latch の計数が 0 になるまで、期限 deadline まで待つ. 期限を過ぎた場合や期限が不正な場合は false を返す
+ */
+extern bool ChronoLatchWait(chrono_latch_t * latch, chrono_mno_t const * deadline);
+
+
+/*!
+  ラッチ latch の計数が 0 になるまで、期間 timeout だけ待つ. 期限を過ぎた場合は false を返す
+ */
+extern bool ChronoLatchWaitFor(chrono_latch_t * latch, chrono_t const * timeout);
+
+#endif // CHRONO_FUTEX_H
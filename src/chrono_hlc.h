@@ -0,0 +1,144 @@
+/*! @file
+  Chrono : ハイブリッド論理時計モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  システム時刻(ミリ秒)を上位 48 ビット、論理カウンタを下位 16 ビットに詰めた 64 ビットのタイムスタンプを発行する.
+  システム時刻が逆行しても、発行するタイムスタンプは単調に増え、受信したタイムスタンプより必ず後になる.
+  そのため、プロセス間でやり取りしたイベントを、実時間に近い因果順の全順序で並べられる.
+  タイムスタンプの比較は 64 ビット整数の比較 1 回で済む.
+  論理カウンタがあふれた場合は、物理時刻を 1 ミリ秒進めた扱いになる
+*/
+
+#ifndef CHRONO_HLC_H
+#define CHRONO_HLC_H
+
+#include "chrono_pack.h"
+#include <stdatomic.h>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoHlc"
+#endif
+
+/*!
+  論理カウンタのビット数.
+ */
+#define CHRONO_HLC_LOGICAL_BITS 16
+
+
+/*!
+  ハイブリッド論理時計のタイムスタンプ.
+ */
+typedef struct {
+    uint64_t value;  //!< 物理時刻(ミリ秒) << 16 | 論理カウンタ
+} chrono_hlc_stamp_t;
+
+
+/*!
+  ハイブリッド論理時計.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic uint64_t last;  //!< 最後に発行したタイムスタンプ
+} chrono_hlc_t;
+
+
+/*!
+  ハイブリッド論理時計 hlc を初期化する.
+ */
+static inline void ChronoHlcInit(chrono_hlc_t * hlc)
+{
+    atomic_init(&hlc->last, 0);
+}
+
+
+/*!
+  現在のシステム時刻の、論理カウンタ 0 のタイムスタンプ.
+ */
+static inline uint64_t ChronoHlcPhysical(void)
+{
+    chrono_sys_pack_t p = { 0 };
+    ChronoSysPackNow(&p);
+    return (p.value > 0) ? (uint64_t)(p.value / 1000000) << CHRONO_HLC_LOGICAL_BITS : 0;
+}
+
+
+/*!
+  ハイブリッド論理時計 hlc から、ローカルイベント(送信)用のタイムスタンプ stamp を発行する.
+  ロックフリーで、複数スレッドから呼び出せる
+ */
+static inline void ChronoHlcNow(chrono_hlc_t * hlc, chrono_hlc_stamp_t * stamp)
+{
+    uint64_t pt = ChronoHlcPhysical();
+    uint64_t old = atomic_load_explicit(&hlc->last, memory_order_relaxed);
+    uint64_t next;
+    do {
+        // 物理時刻が進んでいれば論理カウンタは 0, そうでなければ最後の値の論理カウンタを進める
+        next = (pt > old) ? pt : old + 1;
+    } while (!atomic_compare_exchange_weak_explicit(&hlc->last, &old, next, memory_order_acq_rel, memory_order_relaxed));
+    stamp->value = next;
+}
+
+
+/*!
+  受信したタイムスタンプ remote をハイブリッド論理時計 hlc に反映し、受信イベント用のタイムスタンプ stamp を発行する.
+  stamp は remote と、これまでに発行したすべてのタイムスタンプより大きい
+ */
+static inline void ChronoHlcUpdate(chrono_hlc_t * hlc, chrono_hlc_stamp_t const * remote, chrono_hlc_stamp_t * stamp)
+{
+    uint64_t pt = ChronoHlcPhysical();
+    uint64_t old = atomic_load_explicit(&hlc->last, memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = (old > remote->value) ? old : remote->value;
+        next = (pt > next) ? pt : next + 1;
+    } while (!atomic_compare_exchange_weak_explicit(&hlc->last, &old, next, memory_order_acq_rel, memory_order_relaxed));
+    stamp->value = next;
+}
+
+
+/*!
+  タイムスタンプ s1 と s2 を比較する.
+  s1 が前なら負数, 同じなら 0, 後なら正数を返す
+ */
+static inline int ChronoHlcComp(chrono_hlc_stamp_t const * s1, chrono_hlc_stamp_t const * s2)
+{
+    return (s1->value > s2->value) - (s1->value < s2->value);
+}
+
+
+/*!
+  タイムスタンプ stamp の論理カウンタを返す.
+ */
+static inline uint16_t ChronoHlcLogical(chrono_hlc_stamp_t const * stamp)
+{
+    return (uint16_t)(stamp->value & ((1u << CHRONO_HLC_LOGICAL_BITS) - 1));
+}
+
+
+/*!
+  タイムスタンプ stamp の物理時刻(ミリ秒精度)をシステム時刻 cs に変換する.
+ */
+static inline void ChronoHlcToSys(chrono_hlc_stamp_t const * stamp, chrono_sys_t * cs)
+{
+    chrono_sys_pack_t p = { (int64_t)(stamp->value >> CHRONO_HLC_LOGICAL_BITS) * 1000000 };
+    ChronoSysUnpack(&p, cs);
+}
+
+
+/*!
+  システム時刻 cs を論理カウンタ 0 のタイムスタンプ stamp に変換する.
+  cs 以降に発行されたタイムスタンプの範囲検索に使う
+ */
+static inline bool ChronoHlcFromSys(chrono_sys_t const * cs, chrono_hlc_stamp_t * stamp)
+{
+    chrono_sys_pack_t p;
+    if (!ChronoSysPack(cs, &p) || p.value < 0)
+        return false;
+    stamp->value = (uint64_t)(p.value / 1000000) << CHRONO_HLC_LOGICAL_BITS;
+    return true;
+}
+
+#endif // CHRONO_HLC_H
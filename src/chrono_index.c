@@ -0,0 +1,216 @@
+/*! @file
+  Chrono : 時刻索引の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_index.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*!
+  予測位置の前後に探す幅. 浮動小数点の丸めの分だけ広げる
+ */
+#define INDEX_RADIUS (CHRONO_INDEX_EPSILON + 2)
+
+static bool indexPush(chrono_index_t * ix, size_t * capacity, size_t first, double lo, double hi)
+{
+    if (ix->nsegments == *capacity) {
+        size_t c = (*capacity) ? *capacity * 2 : 16;
+        chrono_index_segment_t * s = realloc(ix->segments, c * sizeof(*s));
+        if (!s)
+            return false;
+        ix->segments = s;
+        *capacity = c;
+    }
+    chrono_index_segment_t * s = &ix->segments[ix->nsegments++];
+    s->key = ix->keys[first].value;
+    s->first = first;
+    s->slope = (hi == INFINITY) ? 0.0 : (lo + hi) / 2;
+    return true;
+}
+
+/*!
+  bounds[s] < key となる最後の区分 s を返す. bounds[0] < key であること
+ */
+static inline size_t indexSegment(chrono_index_t const * ix, int64_t key)
+{
+    int64_t const * b = ix->bounds;
+    size_t base = 0, n = ix->nsegments;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (b[base + half] < key) ? base + half : base;
+        n -= half;
+    }
+    return base;
+}
+
+/*!
+  key 以上の最初の要素がある範囲 [base, base + n) を求める.
+ */
+static inline void indexWindow(chrono_index_t const * ix, int64_t key, size_t * base, size_t * n)
+{
+    if (ix->count == 0 || key <= ix->keys[0].value) {
+        *base = 0;
+        *n = 1;
+        return;
+    }
+
+    size_t s = indexSegment(ix, key);
+    chrono_index_segment_t const * seg = &ix->segments[s];
+    size_t end = (s + 1 < ix->nsegments) ? ix->segments[s + 1].first : ix->count;
+
+    // 区分の外への外挿は次の区分の先頭で止める
+    double p = (double)seg->first + seg->slope * (double)(key - seg->key);
+    size_t c = (p < (double)end) ? (size_t)p : end;
+    size_t lo = (c > seg->first + INDEX_RADIUS) ? c - INDEX_RADIUS : seg->first;
+    size_t hi = (c + INDEX_RADIUS + 1 < end) ? c + INDEX_RADIUS + 1 : end;
+    *base = lo;
+    *n = hi - lo + 1;
+}
+
+/*!
+  二分探索の 1 段. 答えが [base, base + n) にあるとして範囲を半分にする
+ */
+static inline void indexStep(chrono_sys_pack_t const * keys, int64_t key, size_t * base, size_t * n)
+{
+    size_t half = *n / 2;
+    size_t mid = *base + half;
+    *base = (keys[mid - 1].value < key) ? mid : *base;
+    *n -= half;
+}
+
+static size_t indexLowerBound(chrono_index_t const * ix, int64_t key)
+{
+    size_t base, n;
+    indexWindow(ix, key, &base, &n);
+    while (n > 1)
+        indexStep(ix->keys, key, &base, &n);
+    return base;
+}
+
+bool ChronoIndexInit(chrono_index_t * ix, chrono_sys_pack_t const * keys, size_t n)
+{
+    size_t capacity = 0;
+    ix->keys = keys;
+    ix->count = n;
+    ix->segments = NULL;
+    ix->bounds = NULL;
+    ix->nsegments = 0;
+    if (n == 0)
+        return true;
+
+    // 先頭の点を通る直線の傾きの範囲 [lo, hi] を、誤差を満たすように狭めていく
+    size_t first = 0;
+    double lo = 0.0, hi = INFINITY;
+    for (size_t i = 1; i < n; ++i) {
+        if (keys[i].value < keys[i - 1].value)
+            goto fail;
+
+        double dk = (double)(keys[i].value - keys[first].value);
+        double di = (double)(i - first);
+        bool ok;
+        if (dk == 0) {
+            ok = (di <= CHRONO_INDEX_EPSILON);
+        } else {
+            double l = (di - CHRONO_INDEX_EPSILON) / dk;
+            double h = (di + CHRONO_INDEX_EPSILON) / dk;
+            l = (l > lo) ? l : lo;
+            h = (h < hi) ? h : hi;
+            ok = (l <= h);
+            if (ok) {
+                lo = l;
+                hi = h;
+            }
+        }
+        if (!ok) {
+            if (!indexPush(ix, &capacity, first, lo, hi))
+                goto fail;
+            first = i;
+            lo = 0.0;
+            hi = INFINITY;
+        }
+    }
+    if (!indexPush(ix, &capacity, first, lo, hi))
+        goto fail;
+
+    ix->bounds = malloc(ix->nsegments * sizeof(*ix->bounds));
+    if (!ix->bounds)
+        goto fail;
+    for (size_t s = 0; s < ix->nsegments; ++s)
+        ix->bounds[s] = ix->segments[s].key;
+    return true;
+
+  fail:
+    ChronoIndexDestroy(ix);
+    return false;
+}
+
+void ChronoIndexDestroy(chrono_index_t * ix)
+{
+    free(ix->segments);
+    free(ix->bounds);
+    ix->segments = NULL;
+    ix->bounds = NULL;
+    ix->nsegments = 0;
+    ix->count = 0;
+}
+
+size_t ChronoIndexSegments(chrono_index_t const * ix)
+{
+    return ix->nsegments;
+}
+
+size_t ChronoIndexLowerBound(chrono_index_t const * ix, chrono_sys_pack_t const * key)
+{
+    return indexLowerBound(ix, key->value);
+}
+
+size_t ChronoIndexUpperBound(chrono_index_t const * ix, chrono_sys_pack_t const * key)
+{
+    // 整数なので key より大きい最初の要素は key + 1 以上の最初の要素
+    if (key->value == INT64_MAX)
+        return ix->count;
+    return indexLowerBound(ix, key->value + 1);
+}
+
+size_t ChronoIndexRange(chrono_index_t const * ix, chrono_sys_pack_t const * start, chrono_sys_pack_t const * end,
+                        size_t * first)
+{
+    *first = indexLowerBound(ix, start->value);
+    if (end->value <= start->value)
+        return 0;
+    return indexLowerBound(ix, end->value) - *first;
+}
+
+void ChronoIndexLowerBoundBatch(chrono_index_t const * ix, chrono_sys_pack_t const * keys, size_t * pos, size_t n)
+{
+    size_t base[CHRONO_INDEX_BATCH], len[CHRONO_INDEX_BATCH];
+
+    for (size_t i = 0; i < n; i += CHRONO_INDEX_BATCH) {
+        size_t m = (n - i < CHRONO_INDEX_BATCH) ? n - i : CHRONO_INDEX_BATCH;
+        for (size_t j = 0; j < m; ++j) {
+            indexWindow(ix, keys[i + j].value, &base[j], &len[j]);
+            if (len[j] > 1)
+                __builtin_prefetch(&ix->keys[base[j] + len[j] / 2 - 1]);
+        }
+
+        bool more = true;
+        while (more) {
+            more = false;
+            for (size_t j = 0; j < m; ++j) {
+                if (len[j] > 1) {
+                    indexStep(ix->keys, keys[i + j].value, &base[j], &len[j]);
+                    if (len[j] > 1) {
+                        __builtin_prefetch(&ix->keys[base[j] + len[j] / 2 - 1]);
+                        more = true;
+                    }
+                }
+            }
+        }
+        for (size_t j = 0; j < m; ++j)
+            pos[i + j] = base[j];
+    }
+}
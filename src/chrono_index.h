@@ -0,0 +1,103 @@
+/*! @file
+  Chrono : 時刻索引モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  昇順に並んだ圧縮システム時刻の配列から、時刻の位置を二分探索より少ないメモリアクセスで求める.
+  配列を区分線形関数で近似し(各区分の誤差は CHRONO_INDEX_EPSILON 以内)、
+  予測した位置の前後 CHRONO_INDEX_EPSILON 程度の範囲だけを二分探索する.
+  ほぼ等間隔の時刻列なら区分は数個で済む.
+  配列は複製しないので、索引を使う間は配列を変更・解放しないこと
+*/
+
+#ifndef CHRONO_INDEX_H
+#define CHRONO_INDEX_H
+
+#include "chrono_pack.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoIndex"
+#endif
+
+/*!
+  区分線形近似の最大誤差(要素数).
+ */
+#define CHRONO_INDEX_EPSILON 32
+
+
+/*!
+  一括検索で同時に進める問い合わせの数.
+ */
+#define CHRONO_INDEX_BATCH 16
+
+
+/*!
+  区分. 位置を first + slope * (時刻 - key) で予測する
+ */
+typedef struct {
+    int64_t key;      //!< 先頭の時刻(ナノ秒)
+    size_t first;     //!< 先頭の位置
+    double slope;     //!< 傾き(要素数/ナノ秒)
+} chrono_index_segment_t;
+
+
+/*!
+  時刻索引.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    chrono_sys_pack_t const * keys;      //!< 昇順の時刻の配列
+    size_t count;                        //!< 配列の要素数
+    chrono_index_segment_t * segments;   //!< 区分の配列
+    int64_t * bounds;                    //!< 各区分の先頭の時刻(区分の探索用)
+    size_t nsegments;                    //!< 区分の数
+} chrono_index_t;
+
+
+/*!
+  昇順に並んだ n 個の時刻 keys の索引 ix を作る.
+  keys が昇順でない場合や、メモリ確保に失敗した場合は false を返す
+ */
+extern bool ChronoIndexInit(chrono_index_t * ix, chrono_sys_pack_t const * keys, size_t n);
+
+
+/*!
+  時刻索引 ix を解放する.
+ */
+extern void ChronoIndexDestroy(chrono_index_t * ix);
+
+
+/*!
+  時刻索引 ix の区分の数を返す.
+ */
+extern size_t ChronoIndexSegments(chrono_index_t const * ix);
+
+
+/*!
+  key 以上の最初の要素の位置を返す. なければ要素数を返す
+ */
+extern size_t ChronoIndexLowerBound(chrono_index_t const * ix, chrono_sys_pack_t const * key);
+
+
+/*!
+  key より大きい最初の要素の位置を返す. なければ要素数を返す
+ */
+extern size_t ChronoIndexUpperBound(chrono_index_t const * ix, chrono_sys_pack_t const * key);
+
+
+/*!
+  [start, end) に含まれる要素の先頭の位置を first に設定し、要素数を返す.
+ */
+extern size_t ChronoIndexRange(chrono_index_t const * ix, chrono_sys_pack_t const * start, chrono_sys_pack_t const * end,
+                               size_t * first);
+
+
+/*!
+  n 個の時刻 keys について ChronoIndexLowerBound の結果を pos に設定する.
+  CHRONO_INDEX_BATCH 個ずつ二分探索を 1 段ずつ交互に進め、メモリの読み込みを重ねて待ち時間を隠す
+ */
+extern void ChronoIndexLowerBoundBatch(chrono_index_t const * ix, chrono_sys_pack_t const * keys, size_t * pos, size_t n);
+
+#endif // CHRONO_INDEX_H
@@ -0,0 +1,316 @@
+/*! @file
+  Chrono : 区間索引の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_interval.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * 暗黙の木
+ *
+ * 開始時刻順に並べた配列の添字 i の節点の高さは、i の下位から連続する 1 のビット数 k.
+ * 高さ k の節点 i の子は i - 2^(k-1) と i + 2^(k-1) で、根は 2^K - 1 (K は木の高さ).
+ * 配列の外の節点は空の部分木として扱う
+ */
+
+static int intervalComp(void const * a, void const * b)
+{
+    chrono_interval_node_t const * x = a;
+    chrono_interval_node_t const * y = b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+/*!
+  各節点の部分木の最大終了時刻を求め、木の高さを返す.
+ */
+static int intervalIndex(chrono_interval_node_t * a, size_t n)
+{
+    if (n == 0)
+        return -1;
+
+    size_t last_i = 0;
+    int64_t last = INT64_MIN;
+    for (size_t i = 0; i < n; i += 2) {
+        last_i = i;
+        a[i].max = last = a[i].end;
+    }
+
+    int k;
+    for (k = 1; ((size_t)1 << k) <= n; ++k) {
+        size_t x = (size_t)1 << (k - 1);
+        for (size_t i = (x << 1) - 1; i < n; i += x << 2) {
+            int64_t e = a[i].end;
+            int64_t el = a[i - x].max;
+            int64_t er = (i + x < n) ? a[i + x].max : last;
+            e = (e > el) ? e : el;
+            a[i].max = (e > er) ? e : er;
+        }
+        // 配列の外にはみ出した右の部分木の代わりに使う、末尾の節点を含む部分木の最大値
+        last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+        if (last_i < n && a[last_i].max > last)
+            last = a[last_i].max;
+    }
+    return k - 1;
+}
+
+/*!
+  [st, en) と重なる区間を探す. 見つかった総数を found に足して返す
+ */
+static size_t intervalSearch(chrono_interval_node_t const * a, size_t n, int levels, int64_t st, int64_t en,
+                             uint64_t * ids, size_t max, size_t found)
+{
+    struct {
+        size_t x;
+        int k;
+        bool right;
+    } stack[128];
+
+    if (n == 0)
+        return found;
+
+    int t = 0;
+    stack[t].x = ((size_t)1 << levels) - 1;
+    stack[t].k = levels;
+    stack[t++].right = false;
+    while (t) {
+        size_t x = stack[--t].x;
+        int k = stack[t].k;
+        if (k <= 3) {
+            // 小さな部分木は先頭から順に調べる
+            size_t i = x >> k << k;
+            size_t i1 = i + ((size_t)1 << (k + 1)) - 1;
+            if (i1 > n)
+                i1 = n;
+            for (; i < i1 && a[i].start < en; ++i) {
+                if (st < a[i].end) {
+                    if (found < max)
+                        ids[found] = a[i].id;
+                    ++found;
+                }
+            }
+        } else if (!stack[t].right) {
+            // 左の部分木の最大終了時刻が st 以前なら、左には重なる区間がない
+            size_t y = x - ((size_t)1 << (k - 1));
+            stack[t++].right = true;
+            if (y >= n || a[y].max > st) {
+                stack[t].x = y;
+                stack[t].k = k - 1;
+                stack[t++].right = false;
+            }
+        } else if (x < n && a[x].start < en) {
+            // 節点の開始時刻が en 以降なら、右の部分木もすべて en 以降
+            if (st < a[x].end) {
+                if (found < max)
+                    ids[found] = a[x].id;
+                ++found;
+            }
+            stack[t].x = x + ((size_t)1 << (k - 1));
+            stack[t].k = k - 1;
+            stack[t++].right = false;
+        }
+    }
+    return found;
+}
+
+/*!
+  差分バッファに溜められる要素数.
+ */
+static size_t intervalDeltaLimit(size_t n)
+{
+    size_t r = 1;
+    while (r * r < n)
+        r <<= 1;
+    return (r > CHRONO_INTERVAL_DELTA) ? r : CHRONO_INTERVAL_DELTA;
+}
+
+static bool intervalReserve(chrono_interval_node_t ** p, size_t * capacity, size_t n)
+{
+    if (n <= *capacity)
+        return true;
+    size_t c = (*capacity) ? *capacity : 16;
+    while (c < n)
+        c <<= 1;
+    chrono_interval_node_t * q = realloc(*p, c * sizeof(*q));
+    if (!q)
+        return false;
+    *p = q;
+    *capacity = c;
+    return true;
+}
+
+/*!
+  削除済みの要素を除き、差分バッファを併合して配列を作り直す.
+ */
+static bool intervalMerge(chrono_interval_t * iv)
+{
+    size_t n = iv->count - iv->dead + iv->delta_count;
+    chrono_interval_node_t * a = malloc((n ? n : 1) * sizeof(*a));
+    if (!a)
+        return false;
+
+    qsort(iv->delta, iv->delta_count, sizeof(*iv->delta), intervalComp);
+    size_t i = 0, j = 0, k = 0;
+    while (i < iv->count || j < iv->delta_count) {
+        if (i < iv->count && iv->nodes[i].end == INT64_MIN)
+            ++i;
+        else if (j == iv->delta_count || (i < iv->count && iv->nodes[i].start <= iv->delta[j].start))
+            a[k++] = iv->nodes[i++];
+        else
+            a[k++] = iv->delta[j++];
+    }
+
+    free(iv->nodes);
+    iv->nodes = a;
+    iv->count = iv->capacity = n;
+    iv->dead = 0;
+    iv->delta_count = 0;
+    iv->levels = intervalIndex(a, n);
+    return true;
+}
+
+void ChronoIntervalInit(chrono_interval_t * iv)
+{
+    memset(iv, 0, sizeof(*iv));
+    iv->levels = -1;
+}
+
+void ChronoIntervalDestroy(chrono_interval_t * iv)
+{
+    free(iv->nodes);
+    free(iv->delta);
+    ChronoIntervalInit(iv);
+}
+
+bool ChronoIntervalBuildPack(chrono_interval_t * iv, chrono_sys_pack_t const * starts, chrono_sys_pack_t const * ends,
+                             uint64_t const * ids, size_t n)
+{
+    iv->count = iv->dead = iv->delta_count = 0;
+    iv->levels = -1;
+    if (!intervalReserve(&iv->nodes, &iv->capacity, n))
+        return false;
+
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (starts[i].value < ends[i].value) {
+            iv->nodes[k].start = starts[i].value;
+            iv->nodes[k].end = ends[i].value;
+            iv->nodes[k++].id = ids[i];
+        }
+    }
+    qsort(iv->nodes, k, sizeof(*iv->nodes), intervalComp);
+    iv->count = k;
+    iv->levels = intervalIndex(iv->nodes, k);
+    return true;
+}
+
+bool ChronoIntervalBuild(chrono_interval_t * iv, chrono_sys_t const * starts, chrono_sys_t const * ends,
+                         uint64_t const * ids, size_t n)
+{
+    chrono_sys_pack_t * p = malloc((n ? n : 1) * 2 * sizeof(*p));
+    if (!p)
+        return false;
+    bool ok = ChronoSysPackArray(starts, p, n) && ChronoSysPackArray(ends, p + n, n)
+        && ChronoIntervalBuildPack(iv, p, p + n, ids, n);
+    free(p);
+    return ok;
+}
+
+bool ChronoIntervalInsert(chrono_interval_t * iv, chrono_sys_t const * start, chrono_sys_t const * end, uint64_t id)
+{
+    chrono_sys_pack_t s, e;
+    if (!ChronoSysPack(start, &s) || !ChronoSysPack(end, &e) || s.value >= e.value)
+        return false;
+    if (!intervalReserve(&iv->delta, &iv->delta_capacity, iv->delta_count + 1))
+        return false;
+
+    chrono_interval_node_t * d = &iv->delta[iv->delta_count++];
+    d->start = s.value;
+    d->end = d->max = e.value;
+    d->id = id;
+    if (iv->delta_count > intervalDeltaLimit(iv->count))
+        intervalMerge(iv);
+    return true;
+}
+
+bool ChronoIntervalDelete(chrono_interval_t * iv, chrono_sys_t const * start, chrono_sys_t const * end, uint64_t id)
+{
+    chrono_sys_pack_t s, e;
+    if (!ChronoSysPack(start, &s) || !ChronoSysPack(end, &e))
+        return false;
+
+    for (size_t i = 0; i < iv->delta_count; ++i) {
+        chrono_interval_node_t * d = &iv->delta[i];
+        if (d->start == s.value && d->end == e.value && d->id == id) {
+            *d = iv->delta[--iv->delta_count];
+            return true;
+        }
+    }
+
+    // 開始時刻で二分探索して墓標を立てる. 部分木の最大値は上界のままでよい
+    size_t lo = 0, hi = iv->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (iv->nodes[mid].start < s.value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (; lo < iv->count && iv->nodes[lo].start == s.value; ++lo) {
+        chrono_interval_node_t * a = &iv->nodes[lo];
+        if (a->end == e.value && a->id == id) {
+            a->end = INT64_MIN;
+            if (++iv->dead * 2 > iv->count)
+                intervalMerge(iv);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ChronoIntervalCount(chrono_interval_t const * iv)
+{
+    return iv->count - iv->dead + iv->delta_count;
+}
+
+size_t ChronoIntervalOverlapPack(chrono_interval_t const * iv, chrono_sys_pack_t const * start,
+                                 chrono_sys_pack_t const * end, uint64_t * ids, size_t max)
+{
+    int64_t st = start->value, en = end->value;
+    if (st >= en)
+        return 0;
+
+    size_t found = intervalSearch(iv->nodes, iv->count, iv->levels, st, en, ids, max, 0);
+    for (size_t i = 0; i < iv->delta_count; ++i) {
+        chrono_interval_node_t const * d = &iv->delta[i];
+        if (d->start < en && st < d->end) {
+            if (found < max)
+                ids[found] = d->id;
+            ++found;
+        }
+    }
+    return found;
+}
+
+size_t ChronoIntervalOverlap(chrono_interval_t const * iv, chrono_sys_t const * start, chrono_sys_t const * end,
+                             uint64_t * ids, size_t max)
+{
+    chrono_sys_pack_t s, e;
+    if (!ChronoSysPack(start, &s) || !ChronoSysPack(end, &e))
+        return 0;
+    return ChronoIntervalOverlapPack(iv, &s, &e, ids, max);
+}
+
+size_t ChronoIntervalStab(chrono_interval_t const * iv, chrono_sys_t const * tp, uint64_t * ids, size_t max)
+{
+    chrono_sys_pack_t s, e;
+    if (!ChronoSysPack(tp, &s))
+        return 0;
+    // INT64_MAX は [s, s + 1) を作れないので、空区間として何も含まない
+    e.value = (s.value < INT64_MAX) ? s.value + 1 : INT64_MAX;
+    return ChronoIntervalOverlapPack(iv, &s, &e, ids, max);
+}
@@ -0,0 +1,123 @@
+/*! @file
+  Chrono : 区間索引モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  システム時刻の半開区間 [start, end) の集合から、時刻 T を含む区間や [A, B) と重なる区間を探す.
+  開始時刻順に並べた配列をそのまま暗黙の二分木とみなし、各節点に部分木の最大終了時刻を持たせる.
+  ポインタを持たないため、連続したメモリを先頭から順に読むだけで検索できる.
+  追加は差分バッファに、削除は墓標にためておき、一定量を超えたら配列を作り直す.
+*/
+
+#ifndef CHRONO_INTERVAL_H
+#define CHRONO_INTERVAL_H
+
+#include "chrono_pack.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoInterval"
+#endif
+
+/*!
+  差分バッファの最小の大きさ.
+  差分バッファは √n か、この値のどちらか大きい方まで溜めてから配列に併合する
+ */
+#define CHRONO_INTERVAL_DELTA 256
+
+
+/*!
+  区間.
+ */
+typedef struct {
+    int64_t start;    //!< 開始時刻(ナノ秒, 含む)
+    int64_t end;      //!< 終了時刻(ナノ秒, 含まない). 削除済みなら INT64_MIN
+    int64_t max;      //!< 部分木の最大終了時刻(ナノ秒)
+    uint64_t id;      //!< 利用者の識別子
+} chrono_interval_node_t;
+
+
+/*!
+  区間索引.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    chrono_interval_node_t * nodes;   //!< 開始時刻順の配列(暗黙の木)
+    size_t count;                     //!< nodes の要素数(削除済みを含む)
+    size_t capacity;                  //!< nodes の大きさ
+    int levels;                       //!< 木の高さ
+    size_t dead;                      //!< 削除済みの要素数
+    chrono_interval_node_t * delta;   //!< 差分バッファ
+    size_t delta_count;               //!< 差分バッファの要素数
+    size_t delta_capacity;            //!< 差分バッファの大きさ
+} chrono_interval_t;
+
+
+/*!
+  区間索引 iv を空で初期化する.
+ */
+extern void ChronoIntervalInit(chrono_interval_t * iv);
+
+
+/*!
+  区間索引 iv を解放する.
+ */
+extern void ChronoIntervalDestroy(chrono_interval_t * iv);
+
+
+/*!
+  区間索引 iv を n 個の区間 [starts[i], ends[i]) (識別子 ids[i]) で作り直す.
+  start >= end の空区間は無視する. メモリ確保に失敗すると false を返す
+ */
+extern bool ChronoIntervalBuild(chrono_interval_t * iv, chrono_sys_t const * starts, chrono_sys_t const * ends,
+                                uint64_t const * ids, size_t n);
+
+
+/*!
+  区間索引 iv を n 個の圧縮時刻の区間で作り直す.
+ */
+extern bool ChronoIntervalBuildPack(chrono_interval_t * iv, chrono_sys_pack_t const * starts, chrono_sys_pack_t const * ends,
+                                    uint64_t const * ids, size_t n);
+
+
+/*!
+  区間索引 iv に区間 [start, end) (識別子 id) を加える.
+ */
+extern bool ChronoIntervalInsert(chrono_interval_t * iv, chrono_sys_t const * start, chrono_sys_t const * end, uint64_t id);
+
+
+/*!
+  区間索引 iv から区間 [start, end) (識別子 id) を 1 つ取り除く. 見つからなければ false を返す
+ */
+extern bool ChronoIntervalDelete(chrono_interval_t * iv, chrono_sys_t const * start, chrono_sys_t const * end, uint64_t id);
+
+
+/*!
+  区間索引 iv の区間の数を返す.
+ */
+extern size_t ChronoIntervalCount(chrono_interval_t const * iv);
+
+
+/*!
+  時刻 tp を含む区間の識別子を ids に最大 max 個まで設定し、該当する区間の総数を返す.
+  順序は不定
+ */
+extern size_t ChronoIntervalStab(chrono_interval_t const * iv, chrono_sys_t const * tp, uint64_t * ids, size_t max);
+
+
+/*!
+  [start, end) と重なる区間の識別子を ids に最大 max 個まで設定し、該当する区間の総数を返す.
+  順序は不定
+ */
+extern size_t ChronoIntervalOverlap(chrono_interval_t const * iv, chrono_sys_t const * start, chrono_sys_t const * end,
+                                    uint64_t * ids, size_t max);
+
+
+/*!
+  圧縮時刻の [start, end) と重なる区間の識別子を ids に最大 max 個まで設定し、該当する区間の総数を返す.
+ */
+extern size_t ChronoIntervalOverlapPack(chrono_interval_t const * iv, chrono_sys_pack_t const * start,
+                                        chrono_sys_pack_t const * end, uint64_t * ids, size_t max);
+
+#endif // CHRONO_INTERVAL_H
@@ -0,0 +1,68 @@
+/*! @file
+  Chrono : モノトニック時刻 - システム時刻変換の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_mnosys.h"
+#include "chrono_pack.h"
+
+bool ChronoMnoSysInit(chrono_mnosys_t * ms, chrono_t const * interval)
+{
+    ms->interval = 0;
+    if (interval && interval->value > 0)
+        ms->interval = ChronoGet(interval, chrono_nanoseconds);
+    return ChronoMnoSysSync(ms);
+}
+
+bool ChronoMnoSysSync(chrono_mnosys_t * ms)
+{
+    int64_t width = INT64_MAX;
+    for (int i = 0; i < CHRONO_MNOSYS_SAMPLES; ++i) {
+        struct timespec m1, s, m2;
+        if (clock_gettime(CLOCK_MONOTONIC, &m1) != 0
+            || clock_gettime(CLOCK_REALTIME, &s) != 0
+            || clock_gettime(CLOCK_MONOTONIC, &m2) != 0)
+            return false;
+
+        int64_t lo, hi, sys;
+        ChronoPackFromTimeSpec(&m1, &lo);
+        ChronoPackFromTimeSpec(&m2, &hi);
+        ChronoPackFromTimeSpec(&s, &sys);
+        if (hi - lo < width) {
+            width = hi - lo;
+            ms->synced = lo + width / 2;
+            ms->offset = sys - ms->synced;
+        }
+    }
+    ms->error = (width + 1) / 2;
+    return true;
+}
+
+static void mnosysConv(chrono_mnosys_t * ms, chrono_mno_t const * cm, chrono_sys_t * cs)
+{
+    int64_t ns;
+    ChronoPackFromTimeSpec(&cm->time_point, &ns);
+    if (ms->interval > 0 && ns - ms->synced >= ms->interval)
+        ChronoMnoSysSync(ms);
+    ChronoPackToTimeSpec(ns + ms->offset, &cs->time_point);
+}
+
+void ChronoMnoSysConv(chrono_mnosys_t * ms, chrono_mno_t const * cm, chrono_sys_t * cs)
+{
+    mnosysConv(ms, cm, cs);
+}
+
+void ChronoMnoSysConvArray(chrono_mnosys_t * ms, chrono_mno_t const * cm, chrono_sys_t * cs, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        mnosysConv(ms, &cm[i], &cs[i]);
+}
+
+void ChronoMnoSysError(chrono_mnosys_t const * ms, chrono_t * c)
+{
+    *c = ChronoInit(ms->error, chrono_nanoseconds);
+}
+
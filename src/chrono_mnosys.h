@@ -0,0 +1,75 @@
+/*! @file
+  Chrono : モノトニック時刻 - システム時刻変換モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  CLOCK_REALTIME と CLOCK_MONOTONIC の差(オフセット)を保持しておき、
+  chrono_mno_t を システムコールなしで chrono_sys_t に変換する.
+  オフセットは、モノトニック時刻の読み出しでシステム時刻の読み出しを挟み込み、
+  その幅が最小となる標本から求める. 挟み込んだ幅の半分を推定誤差とする.
+*/
+
+#ifndef CHRONO_MNOSYS_H
+#define CHRONO_MNOSYS_H
+
+#include "chrono_sys.h"
+#include "chrono_mno.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoMnoSys"
+#endif
+
+/*!
+  オフセットの標本数.
+ */
+#ifndef CHRONO_MNOSYS_SAMPLES
+#define CHRONO_MNOSYS_SAMPLES 8
+#endif
+
+
+/*!
+  モノトニック時刻 - システム時刻変換器.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    int64_t offset;    //!< システム時刻 - モノトニック時刻(ナノ秒)
+    int64_t error;     //!< オフセットの推定誤差(ナノ秒)
+    int64_t synced;    //!< 同期したモノトニック時刻(ナノ秒)
+    int64_t interval;  //!< 再同期の間隔(ナノ秒). 0 の場合は再同期しない
+} chrono_mnosys_t;
+
+
+/*!
+  変換器 ms を初期化し、同期する.
+  interval が NULL もしくは 0 以下の場合は、自動で再同期しない.
+ */
+extern bool ChronoMnoSysInit(chrono_mnosys_t * ms, chrono_t const * interval);
+
+
+/*!
+  変換器 ms のオフセットを現在の時刻で同期する.
+ */
+extern bool ChronoMnoSysSync(chrono_mnosys_t * ms);
+
+
+/*!
+  モノトニック時刻 cm をシステム時刻 cs に変換する.
+  cm が前回の同期から再同期の間隔を過ぎている場合のみ、再同期してから変換する
+ */
+extern void ChronoMnoSysConv(chrono_mnosys_t * ms, chrono_mno_t const * cm, chrono_sys_t * cs);
+
+
+/*!
+  n 個のモノトニック時刻 cm[] をシステム時刻 cs[] に変換する.
+ */
+extern void ChronoMnoSysConvArray(chrono_mnosys_t * ms, chrono_mno_t const * cm, chrono_sys_t * cs, size_t n);
+
+
+/*!
+  変換器 ms の推定誤差を c に設定する.
+ */
+extern void ChronoMnoSysError(chrono_mnosys_t const * ms, chrono_t * c);
+
+#endif // CHRONO_MNOSYS_H
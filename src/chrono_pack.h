@@ -0,0 +1,313 @@
+/*! @file
+  Chrono : 圧縮時刻モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  各時刻型を 64 ビットのナノ秒で表す 8 バイトの時刻型を提供する.
+  表現できる範囲は、起点から ±292 年である.
+  大量の時刻を配列で保持する場合に、struct timespec の半分の大きさで済み、
+  比較や時間差は1回の整数演算になる.
+
+  時刻型 chrono_xxx_t に対して、chrono_xxx_pack_t と以下の関数を提供する.
+
+  - void ChronoXxxPackZero(chrono_xxx_pack_t * p) : 時刻 0 を p に設定する
+  - void ChronoXxxPackMin(chrono_xxx_pack_t * p) : 最小の時刻を p に設定する
+  - void ChronoXxxPackMax(chrono_xxx_pack_t * p) : 最大の時刻を p に設定する
+  - bool ChronoXxxPackNow(chrono_xxx_pack_t * p) : 現在の時刻を p に設定する
+  - bool ChronoXxxPackDHMS(chrono_xxx_pack_t * p, int days, int hours, int minutes, int seconds) : (days, hours, minutes, seconds) を p に設定する
+  - void ChronoXxxPackIncr(chrono_xxx_pack_t * p) : 時刻 p を 1 ナノ秒進める. 最大の時刻では変化しない
+  - void ChronoXxxPackDecr(chrono_xxx_pack_t * p) : 時刻 p を 1 ナノ秒戻す. 最小の時刻では変化しない
+  - bool ChronoXxxPackAdd(chrono_xxx_pack_t * p, chrono_t const * c) : 時刻 p に期間 c を加算する
+  - bool ChronoXxxPackAddValue(chrono_xxx_pack_t * p, intmax_t value, chrono_period_t period) : 時刻 p に期間 (value, period) を加算する
+  - bool ChronoXxxPackDiff(chrono_xxx_pack_t const * p1, chrono_xxx_pack_t const * p2, chrono_t * c) : 時刻 p1 - p2 間の時間差(絶対値)を c に設定する
+  - bool ChronoXxxPackDiffNow(chrono_xxx_pack_t const * p, chrono_t * c) : 時刻 p - 現在時刻までの時間差(絶対値)を c に設定する
+  - int ChronoXxxPackComp(chrono_xxx_pack_t const * p1, chrono_xxx_pack_t const * p2) : 時刻 p1 が小さいと <0, p1 が大きいと 0< を返す
+  - void ChronoXxxPackToTimeT(chrono_xxx_pack_t const * p, time_t * t) : 時刻 p を time_t に変換する
+  - void ChronoXxxPackToTimeVal(chrono_xxx_pack_t const * p, struct timeval * tv) : 時刻 p を struct timeval に変換する
+  - void ChronoXxxPackToTimeSpec(chrono_xxx_pack_t const * p, struct timespec * ts) : 時刻 p を struct timespec に変換する
+  - int ChronoXxxPackSleepUntil(chrono_xxx_pack_t const * p, intmax_t value, chrono_period_t period) : 時刻 p から期間 (value, period) 経過するまで待つ
+  - bool ChronoXxxPack(chrono_xxx_t const * src, chrono_xxx_pack_t * dst) : 時刻 src を圧縮する. 範囲外の場合は飽和させて false を返す
+  - void ChronoXxxUnpack(chrono_xxx_pack_t const * src, chrono_xxx_t * dst) : 時刻 src を展開する
+  - bool ChronoXxxPackArray(chrono_xxx_t const * src, chrono_xxx_pack_t * dst, size_t n) : n 個の時刻を圧縮する
+  - void ChronoXxxUnpackArray(chrono_xxx_pack_t const * src, chrono_xxx_t * dst, size_t n) : n 個の時刻を展開する
+*/
+
+#ifndef CHRONO_PACK_H
+#define CHRONO_PACK_H
+
+#include "chrono_sys.h"
+#include "chrono_mno.h"
+#include "chrono_cpu.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoPack"
+#endif
+
+#if defined(CLOCK_BOOTTIME)
+# include "chrono_boot.h"
+#endif
+#if defined(CLOCK_MONOTONIC_RAW)
+# include "chrono_raw.h"
+#endif
+#if defined(CLOCK_TAI)
+# include "chrono_tai.h"
+#endif
+
+/*!
+  struct timespec をナノ秒に圧縮する. 範囲外の場合は飽和させて false を返す.
+ */
+static inline bool ChronoPackFromTimeSpec(struct timespec const * ts, int64_t * ns)
+{
+    if (ts->tv_sec > INT64_MAX / -chrono_nanoseconds - 1) {
+        *ns = INT64_MAX;
+        return false;
+    }
+    if (ts->tv_sec < INT64_MIN / -chrono_nanoseconds + 1) {
+        *ns = INT64_MIN;
+        return false;
+    }
+    *ns = (int64_t)ts->tv_sec * -chrono_nanoseconds + ts->tv_nsec;
+    return true;
+}
+
+/*!
+  ナノ秒を struct timespec に展開する.
+ */
+static inline void ChronoPackToTimeSpec(int64_t ns, struct timespec * ts)
+{
+    int64_t sec = ns / -chrono_nanoseconds;
+    int64_t nsec = ns % -chrono_nanoseconds;
+    if (nsec < 0) {
+        sec -= 1;
+        nsec -= chrono_nanoseconds;
+    }
+    ts->tv_sec = sec;
+    ts->tv_nsec = nsec;
+}
+
+/*!
+  期間 c をナノ秒に変換する. 範囲外の場合は飽和させて false を返す.
+ */
+static inline bool ChronoPackFromChrono(chrono_t const * c, int64_t * ns)
+{
+    __int128 v = (c->period > 0)
+        ? (__int128)c->value * c->period * -chrono_nanoseconds
+        : (__int128)c->value * -chrono_nanoseconds / -(intmax_t)c->period;
+    if (v > INT64_MAX || v < INT64_MIN) {
+        *ns = (v < 0) ? INT64_MIN : INT64_MAX;
+        return false;
+    }
+    *ns = (int64_t)v;
+    return true;
+}
+
+/*!
+  ns に期間 c を加算する. 桁溢れする場合は飽和させて false を返す.
+ */
+static inline bool ChronoPackAddChrono(int64_t * ns, chrono_t const * c)
+{
+    int64_t v;
+    bool ok = ChronoPackFromChrono(c, &v);
+    if (__builtin_add_overflow(*ns, v, ns)) {
+        *ns = (v < 0) ? INT64_MIN : INT64_MAX;
+        return false;
+    }
+    return ok;
+}
+
+/*!
+  ns1 - ns2 間の時間差(絶対値)を c に設定する.
+ */
+static inline bool ChronoPackDiffChrono(int64_t ns1, int64_t ns2, chrono_t * c)
+{
+    uint64_t d = (ns1 < ns2) ? (uint64_t)ns2 - (uint64_t)ns1 : (uint64_t)ns1 - (uint64_t)ns2;
+    *c = ChronoInit((d > INTMAX_MAX) ? INTMAX_MAX : (intmax_t)d, chrono_nanoseconds);
+    return d <= INTMAX_MAX;
+}
+
+#ifndef CHRONO_NO_TIMEVAL
+# define CHRONO_PACK_DEFINE_TIMEVAL(ptype, name)                        \
+    static inline void Chrono ## name ## PackToTimeVal(ptype const * p, struct timeval * tv) \
+    {                                                                   \
+        struct timespec ts;                                             \
+        ChronoPackToTimeSpec(p->value, &ts);                            \
+        tv->tv_sec = ts.tv_sec;                                         \
+        tv->tv_usec = ts.tv_nsec * chrono_microseconds / chrono_nanoseconds; \
+    }
+#else
+# define CHRONO_PACK_DEFINE_TIMEVAL(ptype, name)
+#endif
+
+#ifndef CHRONO_NO_TIMESPEC
+# define CHRONO_PACK_DEFINE_TIMESPEC(ptype, name)                       \
+    static inline void Chrono ## name ## PackToTimeSpec(ptype const * p, struct timespec * ts) \
+    {                                                                   \
+        ChronoPackToTimeSpec(p->value, ts);                             \
+    }
+#else
+# define CHRONO_PACK_DEFINE_TIMESPEC(ptype, name)
+#endif
+
+#ifndef CHRONO_NO_ANY_SLEEP
+# define CHRONO_PACK_DEFINE_SLEEP(type, ptype, name)                    \
+    static inline int Chrono ## name ## PackSleepUntil(ptype const * p, intmax_t value, chrono_period_t cp) \
+    {                                                                   \
+        type tp;                                                        \
+        ChronoPackToTimeSpec(p->value, &tp.time_point);                 \
+        return Chrono ## name ## SleepUntil(&tp, value, cp);            \
+    }
+#else
+# define CHRONO_PACK_DEFINE_SLEEP(type, ptype, name)
+#endif
+
+/*!
+  時刻型 type の圧縮時刻型 ptype と、関数 Chrono ## name ## PackXxx を定義する.
+ */
+#define CHRONO_PACK_DEFINE(type, ptype, name, clock_id)                 \
+    typedef struct {                                                    \
+        int64_t value;                                                  \
+    } ptype;                                                            \
+                                                                        \
+    static inline void Chrono ## name ## PackZero(ptype * p)            \
+    {                                                                   \
+        p->value = 0;                                                   \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## PackMin(ptype * p)             \
+    {                                                                   \
+        p->value = INT64_MIN;                                           \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## PackMax(ptype * p)             \
+    {                                                                   \
+        p->value = INT64_MAX;                                           \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackNow(ptype * p)             \
+    {                                                                   \
+        struct timespec ts;                                             \
+        if (clock_gettime(clock_id, &ts) != 0)                          \
+            return false;                                               \
+        return ChronoPackFromTimeSpec(&ts, &p->value);                  \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackDHMS(ptype * p, int days, int hours, int minutes, int seconds) \
+    {                                                                   \
+        chrono_t c = ChronoInit((((intmax_t)days * 24 + hours) * 60 + minutes) * 60 + seconds, chrono_seconds); \
+        return ChronoPackFromChrono(&c, &p->value);                     \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## PackIncr(ptype * p)            \
+    {                                                                   \
+        if (p->value != INT64_MAX)                                      \
+            ++p->value;                                                 \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## PackDecr(ptype * p)            \
+    {                                                                   \
+        if (p->value != INT64_MIN)                                      \
+            --p->value;                                                 \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackAdd(ptype * p, chrono_t const * c) \
+    {                                                                   \
+        return ChronoPackAddChrono(&p->value, c);                       \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackAddValue(ptype * p, intmax_t value, chrono_period_t cp) \
+    {                                                                   \
+        chrono_t c = ChronoInit(value, cp);                             \
+        return ChronoPackAddChrono(&p->value, &c);                      \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackDiff(ptype const * p1, ptype const * p2, chrono_t * c) \
+    {                                                                   \
+        return ChronoPackDiffChrono(p1->value, p2->value, c);           \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackDiffNow(ptype const * p, chrono_t * c) \
+    {                                                                   \
+        ptype now;                                                      \
+        Chrono ## name ## PackNow(&now);                                \
+        return ChronoPackDiffChrono(p->value, now.value, c);            \
+    }                                                                   \
+                                                                        \
+    static inline int Chrono ## name ## PackComp(ptype const * p1, ptype const * p2) \
+    {                                                                   \
+        return (p1->value > p2->value) - (p1->value < p2->value);       \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## PackToTimeT(ptype const * p, time_t * t) \
+    {                                                                   \
+        struct timespec ts;                                             \
+        ChronoPackToTimeSpec(p->value, &ts);                            \
+        *t = ts.tv_sec;                                                 \
+    }                                                                   \
+                                                                        \
+    CHRONO_PACK_DEFINE_TIMEVAL(ptype, name)                             \
+    CHRONO_PACK_DEFINE_TIMESPEC(ptype, name)                            \
+    CHRONO_PACK_DEFINE_SLEEP(type, ptype, name)                         \
+                                                                        \
+    static inline bool Chrono ## name ## Pack(type const * src, ptype * dst) \
+    {                                                                   \
+        return ChronoPackFromTimeSpec(&src->time_point, &dst->value);   \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## Unpack(ptype const * src, type * dst) \
+    {                                                                   \
+        ChronoPackToTimeSpec(src->value, &dst->time_point);             \
+    }                                                                   \
+                                                                        \
+    static inline bool Chrono ## name ## PackArray(type const * src, ptype * dst, size_t n) \
+    {                                                                   \
+        bool ok = true;                                                 \
+        for (size_t i = 0; i < n; ++i)                                  \
+            ok &= ChronoPackFromTimeSpec(&src[i].time_point, &dst[i].value); \
+        return ok;                                                      \
+    }                                                                   \
+                                                                        \
+    static inline void Chrono ## name ## UnpackArray(ptype const * src, type * dst, size_t n) \
+    {                                                                   \
+        for (size_t i = 0; i < n; ++i)                                  \
+            ChronoPackToTimeSpec(src[i].value, &dst[i].time_point);     \
+    }
+
+/*!
+  圧縮システム時刻.
+ */
+CHRONO_PACK_DEFINE(chrono_sys_t, chrono_sys_pack_t, Sys, CLOCK_REALTIME)
+
+/*!
+  圧縮モノトニック時刻.
+ */
+CHRONO_PACK_DEFINE(chrono_mno_t, chrono_mno_pack_t, Mno, CLOCK_MONOTONIC)
+
+/*!
+  圧縮CPU時刻.
+ */
+CHRONO_PACK_DEFINE(chrono_cpu_t, chrono_cpu_pack_t, Cpu, CLOCK_PROCESS_CPUTIME_ID)
+
+#if defined(CLOCK_BOOTTIME)
+/*!
+  圧縮ブートタイム時刻.
+ */
+CHRONO_PACK_DEFINE(chrono_boot_t, chrono_boot_pack_t, Boot, CLOCK_BOOTTIME)
+#endif
+
+#if defined(CLOCK_MONOTONIC_RAW)
+/*!
+  圧縮生モノトニック時刻.
+ */
+CHRONO_PACK_DEFINE(chrono_raw_t, chrono_raw_pack_t, Raw, CLOCK_MONOTONIC_RAW)
+#endif
+
+#if defined(CLOCK_TAI)
+/*!
+  圧縮TAI時刻.
+ */
+CHRONO_PACK_DEFINE(chrono_tai_t, chrono_tai_pack_t, Tai, CLOCK_TAI)
+#endif
+
+#endif // CHRONO_PACK_H
@@ -0,0 +1,331 @@
+/*! @file
+  Chrono : 期限順スレッドプールの実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_pool.h"
+#include "chrono_pthread.h"
+#include <stdlib.h>
+
+static _Thread_local chrono_pool_worker_t * poolSelf;
+
+static inline bool poolLess(chrono_pool_task_t const * a, chrono_pool_task_t const * b)
+{
+    return a->key < b->key || (a->key == b->key && a->seq < b->seq);
+}
+
+static bool poolPush(chrono_pool_heap_t * h, chrono_pool_task_t const * t)
+{
+    if (h->count == h->capacity) {
+        size_t capacity = h->capacity ? h->capacity * 2 : 64;
+        chrono_pool_task_t * tasks = realloc(h->tasks, sizeof(chrono_pool_task_t) * capacity);
+        if (tasks == NULL)
+            return false;
+        h->tasks = tasks;
+        h->capacity = capacity;
+    }
+    size_t i = h->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!poolLess(t, &h->tasks[parent]))
+            break;
+        h->tasks[i] = h->tasks[parent];
+        i = parent;
+    }
+    h->tasks[i] = *t;
+    return true;
+}
+
+static void poolPop(chrono_pool_heap_t * h, chrono_pool_task_t * t)
+{
+    *t = h->tasks[0];
+    chrono_pool_task_t last = h->tasks[--h->count];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= h->count)
+            break;
+        if (child + 1 < h->count && poolLess(&h->tasks[child + 1], &h->tasks[child]))
+            ++child;
+        if (!poolLess(&h->tasks[child], &last))
+            break;
+        h->tasks[i] = h->tasks[child];
+        i = child;
+    }
+    if (h->count)
+        h->tasks[i] = last;
+}
+
+static inline int64_t poolTop(chrono_pool_heap_t const * h)
+{
+    return h->count ? h->tasks[0].key : INT64_MAX;
+}
+
+static bool poolEnqueue(chrono_pool_worker_t * w, chrono_pool_task_t const * t)
+{
+    pthread_mutex_lock(&w->mutex);
+    bool ok = poolPush(&w->queue, t);
+    atomic_store_explicit(&w->top, poolTop(&w->queue), memory_order_relaxed);
+    pthread_mutex_unlock(&w->mutex);
+    return ok;
+}
+
+static bool poolDequeue(chrono_pool_worker_t * w, chrono_pool_task_t * t)
+{
+    if (atomic_load_explicit(&w->top, memory_order_relaxed) == INT64_MAX)
+        return false;
+    pthread_mutex_lock(&w->mutex);
+    bool ok = w->queue.count > 0;
+    if (ok) {
+        poolPop(&w->queue, t);
+        atomic_store_explicit(&w->top, poolTop(&w->queue), memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&w->mutex);
+    return ok;
+}
+
+/*!
+  先頭の期限が最も近いワーカーから盗む.
+ */
+static bool poolSteal(chrono_pool_t * pool, chrono_pool_worker_t * self, chrono_pool_task_t * t)
+{
+    for (;;) {
+        chrono_pool_worker_t * victim = NULL;
+        int64_t best = INT64_MAX;
+        for (int i = 0; i < pool->nworkers; ++i) {
+            chrono_pool_worker_t * w = &pool->workers[i];
+            int64_t top = atomic_load_explicit(&w->top, memory_order_relaxed);
+            if (w != self && top < best) {
+                best = top;
+                victim = w;
+            }
+        }
+        if (victim == NULL)
+            return false;
+        if (poolDequeue(victim, t)) {
+            atomic_fetch_add_explicit(&pool->stolen, 1, memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+/*!
+  開始時刻 now までの遅延タスクを、ワーカー self のキューに移し、移した数だけ待機中のワーカーを起こす.
+  pool->mutex をロックしておくこと
+ */
+static int poolPromote(chrono_pool_t * pool, chrono_pool_worker_t * self, int64_t now)
+{
+    int n = 0;
+    while (pool->delayed.count && pool->delayed.tasks[0].key <= now) {
+        chrono_pool_task_t t;
+        poolPop(&pool->delayed, &t);
+        t.key = t.deadline;
+        poolEnqueue(self, &t);
+        ++n;
+    }
+    atomic_store(&pool->delayed_top, poolTop(&pool->delayed));
+    atomic_fetch_add(&pool->ready, n);
+    for (int i = 0, idle = atomic_load(&pool->idle); i < n && i < idle; ++i)
+        pthread_cond_signal(&pool->cond);
+    return n;
+}
+
+static int64_t poolNow(void)
+{
+    chrono_mno_pack_t p = { 0 };
+    ChronoMnoPackNow(&p);
+    return p.value;
+}
+
+static void poolRun(chrono_pool_t * pool, chrono_pool_task_t const * t)
+{
+    atomic_fetch_sub(&pool->ready, 1);
+    t->fn(t->arg);
+    if (poolNow() > t->deadline)
+        atomic_fetch_add_explicit(&pool->missed, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool->executed, 1, memory_order_relaxed);
+}
+
+static void * poolMain(void * arg)
+{
+    chrono_pool_worker_t * self = arg;
+    chrono_pool_t * pool = self->pool;
+    poolSelf = self;
+
+    for (;;) {
+        chrono_pool_task_t t;
+        if (atomic_load_explicit(&pool->delayed_top, memory_order_relaxed) <= poolNow()) {
+            pthread_mutex_lock(&pool->mutex);
+            poolPromote(pool, self, poolNow());
+            pthread_mutex_unlock(&pool->mutex);
+        }
+        if (poolDequeue(self, &t) || poolSteal(pool, self, &t)) {
+            poolRun(pool, &t);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        if (poolPromote(pool, self, poolNow()) == 0) {
+            atomic_fetch_add(&pool->idle, 1);
+            if (atomic_load(&pool->ready) == 0) {
+                if (pool->stopping) {
+                    atomic_fetch_sub(&pool->idle, 1);
+                    pthread_mutex_unlock(&pool->mutex);
+                    break;
+                }
+                if (pool->delayed.count) {
+                    chrono_mno_pack_t p = { pool->delayed.tasks[0].key };
+                    chrono_mno_t deadline;
+                    ChronoMnoUnpack(&p, &deadline);
+                    ChronoCondWait(&pool->cond, &pool->mutex, &deadline);
+                } else {
+                    ChronoCondWait(&pool->cond, &pool->mutex, NULL);
+                }
+            }
+            atomic_fetch_sub(&pool->idle, 1);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    return NULL;
+}
+
+bool ChronoPoolInit(chrono_pool_t * pool, int nworkers)
+{
+    int i;
+    if (nworkers <= 0)
+        return false;
+    *pool = (chrono_pool_t){ 0 };
+    pool->workers = calloc(nworkers, sizeof(chrono_pool_worker_t));
+    if (pool->workers == NULL)
+        return false;
+    if (pthread_mutex_init(&pool->mutex, NULL) != 0)
+        goto fail_workers;
+    if (!ChronoCondInit(&pool->cond))
+        goto fail_mutex;
+    atomic_init(&pool->delayed_top, INT64_MAX);
+
+    for (i = 0; i < nworkers; ++i) {
+        chrono_pool_worker_t * w = &pool->workers[i];
+        if (pthread_mutex_init(&w->mutex, NULL) != 0)
+            goto fail_worker_mutex;
+        atomic_init(&w->top, INT64_MAX);
+        w->pool = pool;
+    }
+    for (i = 0; i < nworkers; ++i) {
+        if (pthread_create(&pool->workers[i].thread, NULL, poolMain, &pool->workers[i]) != 0) {
+            // スレッドを作れなかったワーカーのミューテックスは ChronoPoolDestroy が扱わないので、ここで破棄する
+            for (int j = i; j < nworkers; ++j)
+                pthread_mutex_destroy(&pool->workers[j].mutex);
+            pool->nworkers = i;
+            ChronoPoolDestroy(pool);
+            return false;
+        }
+        pool->nworkers = i + 1;
+    }
+    return true;
+
+fail_worker_mutex:
+    while (i-- > 0)
+        pthread_mutex_destroy(&pool->workers[i].mutex);
+    pthread_cond_destroy(&pool->cond);
+fail_mutex:
+    pthread_mutex_destroy(&pool->mutex);
+fail_workers:
+    free(pool->workers);
+    pool->workers = NULL;
+    return false;
+}
+
+void ChronoPoolDestroy(chrono_pool_t * pool)
+{
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->nworkers; ++i)
+        pthread_join(pool->workers[i].thread, NULL);
+    for (int i = 0; i < pool->nworkers; ++i) {
+        pthread_mutex_destroy(&pool->workers[i].mutex);
+        free(pool->workers[i].queue.tasks);
+    }
+    free(pool->workers);
+    free(pool->delayed.tasks);
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->mutex);
+    pool->workers = NULL;
+    pool->nworkers = 0;
+}
+
+static bool poolTask(chrono_pool_t * pool, chrono_mno_t const * deadline, chrono_pool_fn_t fn, void * arg,
+                     chrono_pool_task_t * t)
+{
+    chrono_mno_pack_t p;
+    if (fn == NULL)
+        return false;
+    ChronoMnoPack(deadline, &p);
+    t->key = t->deadline = p.value;
+    t->seq = atomic_fetch_add_explicit(&pool->seq, 1, memory_order_relaxed);
+    t->fn = fn;
+    t->arg = arg;
+    return true;
+}
+
+bool ChronoPoolSubmit(chrono_pool_t * pool, chrono_mno_t const * deadline, chrono_pool_fn_t fn, void * arg)
+{
+    chrono_pool_task_t t;
+    if (!poolTask(pool, deadline, fn, arg, &t))
+        return false;
+
+    chrono_pool_worker_t * w = poolSelf;
+    if (w == NULL || w->pool != pool)
+        w = &pool->workers[atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed) % pool->nworkers];
+    // ワーカーは idle を増やしてから ready を確認するので、起こし損ねない
+    atomic_fetch_add(&pool->ready, 1);
+    if (!poolEnqueue(w, &t)) {
+        atomic_fetch_sub(&pool->ready, 1);
+        return false;
+    }
+    if (atomic_load(&pool->idle) > 0) {
+        pthread_mutex_lock(&pool->mutex);
+        pthread_cond_signal(&pool->cond);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    return true;
+}
+
+bool ChronoPoolSubmitAt(chrono_pool_t * pool, chrono_mno_t const * start, chrono_mno_t const * deadline,
+                        chrono_pool_fn_t fn, void * arg)
+{
+    chrono_pool_task_t t;
+    chrono_mno_pack_t p;
+    if (!poolTask(pool, deadline, fn, arg, &t))
+        return false;
+    ChronoMnoPack(start, &p);
+    t.key = p.value;
+
+    pthread_mutex_lock(&pool->mutex);
+    bool ok = poolPush(&pool->delayed, &t);
+    atomic_store(&pool->delayed_top, poolTop(&pool->delayed));
+    pthread_cond_signal(&pool->cond);  // 待機時間を計算し直させる
+    pthread_mutex_unlock(&pool->mutex);
+    return ok;
+}
+
+uint64_t ChronoPoolExecuted(chrono_pool_t const * pool)
+{
+    return atomic_load(&pool->executed);
+}
+
+uint64_t ChronoPoolMissed(chrono_pool_t const * pool)
+{
+    return atomic_load(&pool->missed);
+}
+
+uint64_t ChronoPoolStolen(chrono_pool_t const * pool)
+{
+    return atomic_load(&pool->stolen);
+}
@@ -0,0 +1,131 @@
+/*! @file
+  Chrono : 期限順スレッドプールモジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  各ワーカーのキューを期限(圧縮モノトニック時刻)順のヒープにし、期限の近いタスクから実行する(EDF).
+  自分のキューが空になったワーカーは、先頭の期限が最も近いワーカーからタスクを盗む.
+  開始時刻を指定した遅延タスクは、開始時刻になってからキューに入る
+*/
+
+#ifndef CHRONO_POOL_H
+#define CHRONO_POOL_H
+
+#include "chrono_pack.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoPool"
+#endif
+
+/*!
+  タスクの関数.
+ */
+typedef void (*chrono_pool_fn_t)(void * arg);
+
+
+/*!
+  タスク.
+ */
+typedef struct {
+    int64_t key;          //!< 順序付けの時刻(ナノ秒). キューでは期限、遅延タスクでは開始時刻
+    int64_t deadline;     //!< 期限(ナノ秒)
+    uint64_t seq;         //!< 同じ時刻は投入順
+    chrono_pool_fn_t fn;  //!< 関数
+    void * arg;           //!< 関数の引数
+} chrono_pool_task_t;
+
+
+/*!
+  タスクのヒープ.
+ */
+typedef struct {
+    chrono_pool_task_t * tasks;
+    size_t count;
+    size_t capacity;
+} chrono_pool_heap_t;
+
+
+struct chrono_pool;
+
+/*!
+  ワーカー.
+ */
+typedef struct {
+    pthread_mutex_t mutex;        //!< queue の保護
+    chrono_pool_heap_t queue;     //!< 実行可能なタスク
+    _Atomic int64_t top;          //!< 先頭の期限. 空の場合は INT64_MAX
+    pthread_t thread;
+    struct chrono_pool * pool;
+} chrono_pool_worker_t;
+
+
+/*!
+  期限順スレッドプール.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct chrono_pool {
+    chrono_pool_worker_t * workers;
+    int nworkers;
+    pthread_mutex_t mutex;         //!< delayed と待機の保護
+    pthread_cond_t cond;           //!< 待機中のワーカー
+    chrono_pool_heap_t delayed;    //!< 遅延タスク
+    _Atomic int64_t delayed_top;   //!< 最も早い開始時刻. 空の場合は INT64_MAX
+    _Atomic int64_t ready;         //!< キューにあるタスク数
+    _Atomic int idle;              //!< 待機中のワーカー数
+    _Atomic uint64_t seq;          //!< 投入順
+    _Atomic uint64_t next;         //!< 投入先のワーカー
+    _Atomic uint64_t executed;     //!< 実行したタスク数
+    _Atomic uint64_t missed;       //!< 期限を過ぎて完了したタスク数
+    _Atomic uint64_t stolen;       //!< 盗んだタスク数
+    bool stopping;                 //!< 停止中か
+} chrono_pool_t;
+
+
+/*!
+  スレッドプール pool を nworkers 個のワーカーで開始する.
+ */
+extern bool ChronoPoolInit(chrono_pool_t * pool, int nworkers);
+
+
+/*!
+  スレッドプール pool を停止する.
+  キューにあるタスクはすべて実行するが、開始時刻前の遅延タスクは破棄する
+ */
+extern void ChronoPoolDestroy(chrono_pool_t * pool);
+
+
+/*!
+  スレッドプール pool に期限 deadline のタスク fn(arg) を投入する.
+ */
+extern bool ChronoPoolSubmit(chrono_pool_t * pool, chrono_mno_t const * deadline, chrono_pool_fn_t fn, void * arg);
+
+
+/*!
+  スレッドプール pool に、開始時刻 start 以降に実行する期限 deadline のタスク fn(arg) を投入する.
+ */
+extern bool ChronoPoolSubmitAt(chrono_pool_t * pool, chrono_mno_t const * start, chrono_mno_t const * deadline,
+                               chrono_pool_fn_t fn, void * arg);
+
+
+/*!
+  スレッドプール pool で実行したタスク数を返す.
+ */
+extern uint64_t ChronoPoolExecuted(chrono_pool_t const * pool);
+
+
+/*!
+  スレッドプール pool で期限を過ぎて完了したタスク数を返す.
+ */
+extern uint64_t ChronoPoolMissed(chrono_pool_t const * pool);
+
+
+/*!
+  スレッドプール pool で他のワーカーから盗んだタスク数を返す.
+ */
+extern uint64_t ChronoPoolStolen(chrono_pool_t const * pool);
+
+#endif // CHRONO_POOL_H
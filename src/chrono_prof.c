@@ -0,0 +1,239 @@
+/*! @file
+  Chrono : CPU時間サンプリングプロファイラの実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // dladdr, gettid, SIGEV_THREAD_ID
+#endif
+#include "chrono_prof.h"
+#include "chrono_pack.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if !defined(sigev_notify_thread_id)
+# define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+/*!
+  ハンドラ自身とシグナルトランポリンのフレーム数.
+ */
+#define PROF_SKIP 2
+
+static _Atomic(chrono_prof_t *) profActive;
+
+static int64_t profThreadCpu(void)
+{
+    struct timespec ts;
+    int64_t ns = 0;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        ChronoPackFromTimeSpec(&ts, &ns);
+    return ns;
+}
+
+/*!
+  シグナルハンドラ. async-signal-safe な処理のみ行う
+ */
+static void profHandler(int sig, siginfo_t * info, void * ucontext)
+{
+    (void)sig;
+    (void)ucontext;
+    chrono_prof_t * prof = info->si_value.sival_ptr;
+    if (info->si_code != SI_TIMER || prof == NULL)
+        return;
+
+    // 先に inflight を増やしてから確認する. 逆順だと、その間に Stop が完了してバッファを解放しうる
+    atomic_fetch_add(&prof->inflight, 1);
+    if (prof != atomic_load(&profActive)) {
+        atomic_fetch_sub(&prof->inflight, 1);
+        return;
+    }
+
+    int saved = errno;
+    int64_t start = profThreadCpu();
+
+    size_t i = atomic_fetch_add_explicit(&prof->count, 1, memory_order_relaxed);
+    if (i < prof->capacity) {
+        void * pc[CHRONO_PROF_DEPTH + PROF_SKIP];
+        int n = backtrace(pc, CHRONO_PROF_DEPTH + PROF_SKIP) - PROF_SKIP;
+        chrono_prof_sample_t * s = &prof->samples[i];
+        s->depth = (n < 0) ? 0 : n;
+        memcpy(s->pc, pc + PROF_SKIP, sizeof(void *) * s->depth);
+    } else {
+        atomic_fetch_add_explicit(&prof->dropped, 1, memory_order_relaxed);
+    }
+
+    atomic_fetch_add_explicit(&prof->overhead, profThreadCpu() - start, memory_order_relaxed);
+    atomic_fetch_sub(&prof->inflight, 1);
+    errno = saved;
+}
+
+bool ChronoProfInit(chrono_prof_t * prof, size_t capacity)
+{
+    memset(prof, 0, sizeof(*prof));
+    prof->samples = calloc(capacity, sizeof(chrono_prof_sample_t));
+    if (prof->samples == NULL)
+        return false;
+    prof->capacity = capacity;
+    return true;
+}
+
+void ChronoProfDestroy(chrono_prof_t * prof)
+{
+    ChronoProfStop(prof);
+    free(prof->samples);
+    prof->samples = NULL;
+    prof->capacity = 0;
+}
+
+bool ChronoProfStart(chrono_prof_t * prof, chrono_prof_clock_t clock, chrono_t const * interval)
+{
+    chrono_prof_t * expected = NULL;
+    if (prof->started || !atomic_compare_exchange_strong(&profActive, &expected, prof))
+        return false;
+
+    // backtrace は初回に libgcc を読み込むので、ハンドラ外で済ませておく
+    void * warm[2];
+    backtrace(warm, 2);
+
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_signo = CHRONO_PROF_SIGNAL;
+    sev.sigev_value.sival_ptr = prof;
+
+    clockid_t id;
+    if (clock == chrono_prof_thread) {
+        if (pthread_getcpuclockid(pthread_self(), &id) != 0)
+            goto fail;
+        sev.sigev_notify = SIGEV_THREAD_ID;
+        sev.sigev_notify_thread_id = gettid();
+    } else {
+        id = CLOCK_PROCESS_CPUTIME_ID;
+        sev.sigev_notify = SIGEV_SIGNAL;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = profHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(CHRONO_PROF_SIGNAL, &sa, &prof->old) != 0)
+        goto fail;
+
+    if (timer_create(id, &sev, &prof->timer) != 0)
+        goto restore;
+
+    intmax_t ns = ChronoGet(interval, chrono_nanoseconds);
+    if (ns < CHRONO_PROF_MIN_INTERVAL)
+        ns = CHRONO_PROF_MIN_INTERVAL;
+    struct itimerspec its;
+    its.it_interval.tv_sec = ns / -chrono_nanoseconds;
+    its.it_interval.tv_nsec = ns % -chrono_nanoseconds;
+    its.it_value = its.it_interval;
+    if (timer_settime(prof->timer, 0, &its, NULL) != 0) {
+        timer_delete(prof->timer);
+        goto restore;
+    }
+
+    prof->started = true;
+    return true;
+
+ restore:
+    sigaction(CHRONO_PROF_SIGNAL, &prof->old, NULL);
+ fail:
+    atomic_store(&profActive, NULL);
+    return false;
+}
+
+bool ChronoProfStop(chrono_prof_t * prof)
+{
+    if (!prof->started)
+        return false;
+    timer_delete(prof->timer);
+    atomic_store(&profActive, NULL);
+    while (atomic_load(&prof->inflight) != 0)
+        sched_yield();
+    sigaction(CHRONO_PROF_SIGNAL, &prof->old, NULL);
+    prof->started = false;
+    return true;
+}
+
+void ChronoProfReset(chrono_prof_t * prof)
+{
+    atomic_store(&prof->count, 0);
+    atomic_store(&prof->dropped, 0);
+    atomic_store(&prof->overhead, 0);
+}
+
+size_t ChronoProfSamples(chrono_prof_t const * prof)
+{
+    size_t n = atomic_load(&prof->count);
+    return (n < prof->capacity) ? n : prof->capacity;
+}
+
+uint64_t ChronoProfDropped(chrono_prof_t const * prof)
+{
+    return atomic_load(&prof->dropped);
+}
+
+void ChronoProfOverhead(chrono_prof_t const * prof, chrono_t * c)
+{
+    *c = ChronoInit(atomic_load(&prof->overhead), chrono_nanoseconds);
+}
+
+static int profComp(void const * lhs, void const * rhs)
+{
+    chrono_prof_sample_t const * a = lhs;
+    chrono_prof_sample_t const * b = rhs;
+    if (a->depth != b->depth)
+        return (a->depth < b->depth) ? -1 : 1;
+    return memcmp(a->pc, b->pc, sizeof(void *) * a->depth);
+}
+
+static void profWriteFrame(void * pc, FILE * fp)
+{
+    Dl_info info;
+    if (!dladdr(pc, &info)) {
+        fprintf(fp, "%p", pc);
+    } else if (info.dli_sname) {
+        fputs(info.dli_sname, fp);
+    } else if (info.dli_fname) {
+        char const * base = strrchr(info.dli_fname, '/');
+        fprintf(fp, "%s+%#lx", base ? base + 1 : info.dli_fname,
+                (unsigned long)((char *)pc - (char *)info.dli_fbase));
+    } else {
+        fprintf(fp, "%p", pc);
+    }
+}
+
+bool ChronoProfWriteFolded(chrono_prof_t * prof, FILE * fp)
+{
+    if (prof->started)
+        return false;
+
+    size_t n = ChronoProfSamples(prof);
+    qsort(prof->samples, n, sizeof(chrono_prof_sample_t), profComp);
+    for (size_t i = 0; i < n; ) {
+        size_t j = i + 1;
+        while (j < n && profComp(&prof->samples[i], &prof->samples[j]) == 0)
+            ++j;
+
+        chrono_prof_sample_t const * s = &prof->samples[i];
+        for (int k = s->depth - 1; k >= 0; --k) {
+            profWriteFrame(s->pc[k], fp);
+            if (k)
+                fputc(';', fp);
+        }
+        fprintf(fp, " %zu\n", j - i);
+        i = j;
+    }
+    return !ferror(fp);
+}
@@ -0,0 +1,140 @@
+/*! @file
+  Chrono : CPU時間サンプリングプロファイラモジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  chrono_cpu_t と同じ CPU 時間クロックで timer_create し、
+  一定の CPU 時間ごとにシグナルハンドラでスタックを採取する.
+  採取先は事前に確保したバッファで、ハンドラ内ではメモリ確保もロックもしない.
+  結果は flame graph 用の folded 形式で出力する.
+  関数名を解決するには、実行ファイルを -rdynamic でリンクすること
+*/
+
+#ifndef CHRONO_PROF_H
+#define CHRONO_PROF_H
+
+#include "chrono_cpu.h"
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoProf"
+#endif
+
+/*!
+  採取するスタックの最大の深さ.
+ */
+#ifndef CHRONO_PROF_DEPTH
+#define CHRONO_PROF_DEPTH 32
+#endif
+
+/*!
+  採取に使うシグナル.
+ */
+#ifndef CHRONO_PROF_SIGNAL
+#define CHRONO_PROF_SIGNAL SIGPROF
+#endif
+
+/*!
+  採取間隔の下限(ナノ秒). これより短い間隔は切り上げる
+ */
+#ifndef CHRONO_PROF_MIN_INTERVAL
+#define CHRONO_PROF_MIN_INTERVAL 100000
+#endif
+
+
+/*!
+  計測するCPU時間クロック.
+ */
+typedef enum {
+    chrono_prof_process,  //!< プロセス全体 (CLOCK_PROCESS_CPUTIME_ID). 実行中のスレッドから採取する
+    chrono_prof_thread,   //!< 呼び出したスレッド. SIGEV_THREAD_ID でそのスレッドにのみ配送する
+} chrono_prof_clock_t;
+
+
+/*!
+  スタックの標本.
+ */
+typedef struct {
+    int depth;                       //!< スタックの深さ
+    void * pc[CHRONO_PROF_DEPTH];    //!< 呼び出し元から順のアドレス(葉が先頭)
+} chrono_prof_sample_t;
+
+
+/*!
+  サンプリングプロファイラ.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    chrono_prof_sample_t * samples;  //!< 標本バッファ
+    size_t capacity;                 //!< 標本バッファの大きさ
+    _Atomic size_t count;            //!< 採取を試みた標本数
+    _Atomic uint64_t dropped;        //!< バッファが一杯で捨てた標本数
+    _Atomic int64_t overhead;        //!< ハンドラで消費したCPU時間(ナノ秒)
+    _Atomic int inflight;            //!< 実行中のハンドラ数
+    timer_t timer;                   //!< CPU時間タイマー
+    bool started;                    //!< 採取中か
+    struct sigaction old;            //!< 元のシグナルハンドラ
+} chrono_prof_t;
+
+
+/*!
+  プロファイラ prof を標本 capacity 個分のバッファで初期化する.
+ */
+extern bool ChronoProfInit(chrono_prof_t * prof, size_t capacity);
+
+
+/*!
+  プロファイラ prof を停止し、バッファを解放する.
+ */
+extern void ChronoProfDestroy(chrono_prof_t * prof);
+
+
+/*!
+  プロファイラ prof の採取を開始する. 採取間隔は CPU 時間 interval ごと.
+  同時に採取できるプロファイラは 1 つだけ.
+  CPU 時間タイマーの精度はカーネルのティックに依存するので、短い間隔は間引かれることがある
+ */
+extern bool ChronoProfStart(chrono_prof_t * prof, chrono_prof_clock_t clock, chrono_t const * interval);
+
+
+/*!
+  プロファイラ prof の採取を停止する. 実行中のハンドラの終了を待つ
+ */
+extern bool ChronoProfStop(chrono_prof_t * prof);
+
+
+/*!
+  プロファイラ prof の標本を破棄する. 停止中に呼び出すこと
+ */
+extern void ChronoProfReset(chrono_prof_t * prof);
+
+
+/*!
+  プロファイラ prof に保存された標本数を返す.
+ */
+extern size_t ChronoProfSamples(chrono_prof_t const * prof);
+
+
+/*!
+  プロファイラ prof でバッファが一杯で捨てた標本数を返す.
+ */
+extern uint64_t ChronoProfDropped(chrono_prof_t const * prof);
+
+
+/*!
+  プロファイラ prof のハンドラが消費したCPU時間の合計を c に設定する.
+ */
+extern void ChronoProfOverhead(chrono_prof_t const * prof, chrono_t * c);
+
+
+/*!
+  プロファイラ prof の標本を folded 形式 ("root;...;leaf 件数") で fp に出力する.
+  シンボルが解決できないフレームは "module+0xoffset" で出力する. 停止中に呼び出すこと
+ */
+extern bool ChronoProfWriteFolded(chrono_prof_t * prof, FILE * fp);
+
+#endif // CHRONO_PROF_H
@@ -0,0 +1,101 @@
+/*! @file
+  Chrono : pthread 待機補助の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // pthread_mutex_clocklock, sem_clockwait
+#endif
+#include "chrono_pthread.h"
+#include "chrono_deadline.h"
+#include <errno.h>
+
+bool ChronoCondInit(pthread_cond_t * cond)
+{
+    pthread_condattr_t attr;
+    if (pthread_condattr_init(&attr) != 0)
+        return false;
+    bool ok = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) == 0 && pthread_cond_init(cond, &attr) == 0;
+    pthread_condattr_destroy(&attr);
+    return ok;
+}
+
+int ChronoCondWait(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_mno_t const * deadline)
+{
+    if (deadline == NULL)
+        return pthread_cond_wait(cond, mutex);
+    struct timespec ts;
+    ChronoMnoToTimeSpec(deadline, &ts);
+    return pthread_cond_timedwait(cond, mutex, &ts);
+}
+
+int ChronoCondWaitFor(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    return ChronoCondWait(cond, mutex, ChronoDeadlineAfter(timeout, &deadline));
+}
+
+bool ChronoCondWaitPred(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_mno_t const * deadline,
+                        chrono_pred_t pred, void * arg)
+{
+    // 見せかけの起床でも、同じ絶対時刻で待ち直す
+    while (!pred(arg)) {
+        int r = ChronoCondWait(cond, mutex, deadline);
+        if (r == ETIMEDOUT)
+            return pred(arg);
+        if (r != 0 && r != EINTR)  // 期限が不正な場合など
+            return false;
+    }
+    return true;
+}
+
+bool ChronoCondWaitPredFor(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_t const * timeout,
+                           chrono_pred_t pred, void * arg)
+{
+    chrono_mno_t deadline;
+    if (pred(arg))
+        return true;
+    return ChronoCondWaitPred(cond, mutex, ChronoDeadlineAfter(timeout, &deadline), pred, arg);
+}
+
+int ChronoMutexLock(pthread_mutex_t * mutex, chrono_mno_t const * deadline)
+{
+    if (deadline == NULL)
+        return pthread_mutex_lock(mutex);
+    struct timespec ts;
+    ChronoMnoToTimeSpec(deadline, &ts);
+    return pthread_mutex_clocklock(mutex, CLOCK_MONOTONIC, &ts);
+}
+
+int ChronoMutexLockFor(pthread_mutex_t * mutex, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    if (pthread_mutex_trylock(mutex) == 0)
+        return 0;
+    return ChronoMutexLock(mutex, ChronoDeadlineAfter(timeout, &deadline));
+}
+
+int ChronoPosixSemWait(sem_t * sem, chrono_mno_t const * deadline)
+{
+    struct timespec ts;
+    if (deadline)
+        ChronoMnoToTimeSpec(deadline, &ts);
+    for (;;) {
+        int r = deadline ? sem_clockwait(sem, CLOCK_MONOTONIC, &ts) : sem_wait(sem);
+        if (r == 0)
+            return 0;
+        if (errno != EINTR)
+            return errno;
+    }
+}
+
+int ChronoPosixSemWaitFor(sem_t * sem, chrono_t const * timeout)
+{
+    chrono_mno_t deadline;
+    if (sem_trywait(sem) == 0)
+        return 0;
+    return ChronoPosixSemWait(sem, ChronoDeadlineAfter(timeout, &deadline));
+}
@@ -0,0 +1,89 @@
+/*! @file
+  Chrono : pthread 待機補助モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  条件変数を CLOCK_MONOTONIC で作成し、期限を chrono_mno_t の絶対時刻で渡す.
+  見せかけの起床があっても同じ絶対時刻で待ち直すので、待ち時間が伸びたり、システム時刻の変更でずれたりしない.
+  期限に NULL を渡すと、無期限に待つ
+*/
+
+#ifndef CHRONO_PTHREAD_H
+#define CHRONO_PTHREAD_H
+
+#include "chrono_mno.h"
+#include <pthread.h>
+#include <semaphore.h>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoPthread"
+#endif
+
+/*!
+  条件の判定関数.
+ */
+typedef bool (*chrono_pred_t)(void * arg);
+
+
+/*!
+  条件変数 cond を CLOCK_MONOTONIC で初期化する.
+ */
+extern bool ChronoCondInit(pthread_cond_t * cond);
+
+
+/*!
+  条件変数 cond を期限 deadline まで待つ. mutex はロックしておくこと.
+  起床した場合は 0, 期限を過ぎた場合は ETIMEDOUT を返す
+ */
+extern int ChronoCondWait(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_mno_t const * deadline);
+
+
+/*!
+  条件変数 cond を期間 timeout だけ待つ. mutex はロックしておくこと.
+ */
+extern int ChronoCondWaitFor(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_t const * timeout);
+
+
+/*!
+  pred(arg) が真になるまで、条件変数 cond を期限 deadline まで待つ. mutex はロックしておくこと.
+  最後の pred(arg) の結果を返す. 期限が不正な場合は false を返す
+ */
+extern bool ChronoCondWaitPred(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_mno_t const * deadline,
+                               chrono_pred_t pred, void * arg);
+
+
+/*!
+  pred(arg) が真になるまで、条件変数 cond を期間 timeout だけ待つ. mutex はロックしておくこと.
+ */
+extern bool ChronoCondWaitPredFor(pthread_cond_t * cond, pthread_mutex_t * mutex, chrono_t const * timeout,
+                                  chrono_pred_t pred, void * arg);
+
+
+/*!
+  mutex を期限 deadline までにロックする. pthread_mutex_clocklock を使う.
+  ロックした場合は 0, 期限を過ぎた場合は ETIMEDOUT を返す
+ */
+extern int ChronoMutexLock(pthread_mutex_t * mutex, chrono_mno_t const * deadline);
+
+
+/*!
+  mutex を期間 timeout 以内にロックする.
+ */
+extern int ChronoMutexLockFor(pthread_mutex_t * mutex, chrono_t const * timeout);
+
+
+/*!
+  POSIX セマフォ sem を期限 deadline まで待つ. sem_clockwait を使う.
+  減らせた場合は 0, 期限を過ぎた場合は ETIMEDOUT を返す
+ */
+extern int ChronoPosixSemWait(sem_t * sem, chrono_mno_t const * deadline);
+
+
+/*!
+  POSIX セマフォ sem を期間 timeout だけ待つ.
+ */
+extern int ChronoPosixSemWaitFor(sem_t * sem, chrono_t const * timeout);
+
+#endif // CHRONO_PTHREAD_H
@@ -0,0 +1,180 @@
+/*! @file
+  Chrono : 有理数倍率の期間の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_ratio.h"
+
+typedef __int128 ratio_int128_t;
+typedef unsigned __int128 ratio_uint128_t;
+
+static uintmax_t ratioGcd(uintmax_t x, uintmax_t y)
+{
+    while (y) {
+        uintmax_t z = x % y;
+        x = y;
+        y = z;
+    }
+    return x;
+}
+
+static intmax_t ratioSaturate(ratio_int128_t v)
+{
+    return (v > INTMAX_MAX) ? INTMAX_MAX
+        :  (v < INTMAX_MIN) ? INTMAX_MIN
+        :                     (intmax_t)v;
+}
+
+/*!
+  期間 t1, t2 を誤差なく表せる倍率 r と、それぞれの値 v1, v2 を求める.
+  倍率は (分子の最大公約数) / (分母の最小公倍数)
+ */
+static void ratioCommon(chrono_tick_t const * t1, chrono_tick_t const * t2,
+                        chrono_ratio_t * r, ratio_int128_t * v1, ratio_int128_t * v2)
+{
+    intmax_t g = ratioGcd(t1->period.num, t2->period.num);
+    intmax_t l = t1->period.den / ratioGcd(t1->period.den, t2->period.den) * t2->period.den;
+    *r = ChronoRatioInit(g, l);
+    *v1 = (ratio_int128_t)t1->value * (t1->period.num / g) * (l / t1->period.den);
+    *v2 = (ratio_int128_t)t2->value * (t2->period.num / g) * (l / t2->period.den);
+}
+
+static bool ratioArith(chrono_tick_t * t, chrono_tick_t const * rhs, int sign)
+{
+    chrono_ratio_t r;
+    ratio_int128_t v1, v2;
+    ratioCommon(t, rhs, &r, &v1, &v2);
+    v1 += sign * v2;
+    if (v1 > INTMAX_MAX || v1 < INTMAX_MIN)
+        return false;
+    t->value = (intmax_t)v1;
+    t->period = r;
+    return true;
+}
+
+void ChronoRatioFromPeriod(chrono_period_t cp, chrono_ratio_t * r)
+{
+    *r = (cp > 0) ? ChronoRatioInit(cp, 1) : ChronoRatioInit(1, -(intmax_t)cp);
+}
+
+bool ChronoRatioToPeriod(chrono_ratio_t const * r, chrono_period_t * cp)
+{
+    intmax_t g = ratioGcd(r->num, r->den);
+    intmax_t num = r->num / g;
+    intmax_t den = r->den / g;
+    if (den == 1 && num <= INT32_MAX) {
+        *cp = num;
+        return true;
+    }
+    if (num == 1 && den <= INT32_MAX) {
+        *cp = -den;
+        return true;
+    }
+    return false;
+}
+
+intmax_t ChronoTickGet(chrono_tick_t const * t, chrono_ratio_t const * r)
+{
+    ratio_int128_t v = (ratio_int128_t)t->value * t->period.num * r->den;
+    return ratioSaturate(v / ((ratio_int128_t)t->period.den * r->num));
+}
+
+bool ChronoTickAdd(chrono_tick_t * t, chrono_tick_t const * rhs)
+{
+    return ratioArith(t, rhs, 1);
+}
+
+bool ChronoTickSub(chrono_tick_t * t, chrono_tick_t const * rhs)
+{
+    return ratioArith(t, rhs, -1);
+}
+
+int ChronoTickComp(chrono_tick_t const * t1, chrono_tick_t const * t2)
+{
+    chrono_ratio_t r;
+    ratio_int128_t v1, v2;
+    ratioCommon(t1, t2, &r, &v1, &v2);
+    return (v1 > v2) - (v1 < v2);
+}
+
+void ChronoTickFromChrono(chrono_t const * c, chrono_tick_t * t)
+{
+    t->value = c->value;
+    ChronoRatioFromPeriod(c->period, &t->period);
+}
+
+bool ChronoTickToChrono(chrono_tick_t const * t, chrono_t * c)
+{
+    chrono_period_t cp;
+    if (ChronoRatioToPeriod(&t->period, &cp)) {
+        *c = ChronoInit(t->value, cp);
+        return true;
+    }
+
+    ratio_int128_t v = (ratio_int128_t)t->value * t->period.num * -chrono_nanoseconds;
+    *c = ChronoInit(ratioSaturate(v / t->period.den), chrono_nanoseconds);
+    return v % t->period.den == 0 && c->value == v / t->period.den;
+}
+
+bool ChronoRatioConvInit(chrono_ratio_conv_t * rc, chrono_ratio_t const * from, chrono_ratio_t const * to)
+{
+    if (from->num <= 0 || from->den <= 0 || to->num <= 0 || to->den <= 0)
+        return false;
+
+    ratio_uint128_t num = (ratio_uint128_t)from->num * to->den;
+    ratio_uint128_t den = (ratio_uint128_t)from->den * to->num;
+    ratio_uint128_t x = num, y = den;
+    while (y) {
+        ratio_uint128_t z = x % y;
+        x = y;
+        y = z;
+    }
+    num /= x;
+    den /= x;
+    if ((num >> 64) || (den >> 64))
+        return false;
+    rc->num = (uint64_t)num;
+    rc->den = (uint64_t)den;
+
+    // 除数 den の逆数 (Granlund-Montgomery)
+    unsigned l = 0;
+    while (l < 64 && ((ratio_uint128_t)1 << l) < den)
+        ++l;
+    rc->magic = (uint64_t)(((((ratio_uint128_t)1 << l) - den) << 64) / den + 1);
+    rc->shift1 = (l < 1) ? l : 1;
+    rc->shift2 = (l < 1) ? 0 : l - 1;
+    return true;
+}
+
+/*!
+  n / rc->den を逆数の乗算で求める.
+ */
+static uint64_t ratioDiv(chrono_ratio_conv_t const * rc, uint64_t n)
+{
+    uint64_t t = (uint64_t)(((ratio_uint128_t)rc->magic * n) >> 64);
+    return (t + ((n - t) >> rc->shift1)) >> rc->shift2;
+}
+
+intmax_t ChronoRatioConv(chrono_ratio_conv_t const * rc, intmax_t value)
+{
+    uint64_t n = (value < 0) ? -(uint64_t)value : (uint64_t)value;
+    uint64_t q = ratioDiv(rc, n);
+    uint64_t r = n - q * rc->den;
+
+    // 余り r と乗数の積が 64 ビットに収まらない場合は 128 ビットで除算する
+    ratio_uint128_t rn = (ratio_uint128_t)r * rc->num;
+    ratio_uint128_t v = (ratio_uint128_t)q * rc->num
+        + ((rn >> 64) ? rn / rc->den : ratioDiv(rc, (uint64_t)rn));
+    if (v > (ratio_uint128_t)INTMAX_MAX)
+        return (value < 0) ? INTMAX_MIN : INTMAX_MAX;
+    return (value < 0) ? -(intmax_t)v : (intmax_t)v;
+}
+
+void ChronoRatioConvArray(chrono_ratio_conv_t const * rc, intmax_t const * src, intmax_t * dst, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = ChronoRatioConv(rc, src[i]);
+}
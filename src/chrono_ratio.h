@@ -0,0 +1,135 @@
+/*! @file
+  Chrono : 有理数倍率の期間モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  chrono_period_t で表せない 90kHz や 48kHz のような刻みを、
+  分子 / 分母 の有理数倍率で表す期間を提供する.
+  異なる倍率間の演算と比較は、128 ビットの中間値で誤差なく行う.
+  分子と分母は、それぞれ INT32_MAX 以下であること
+*/
+
+#ifndef CHRONO_RATIO_H
+#define CHRONO_RATIO_H
+
+#include "chrono.h"
+#include <stddef.h>
+
+/*!
+  有理数倍率. 1刻み = num / den 秒
+ */
+typedef struct {
+    intmax_t num;  //!< 分子
+    intmax_t den;  //!< 分母
+} chrono_ratio_t;
+
+
+/*!
+  有理数倍率の期間.
+  例えば value = 3, period = { 1, 90000 } の場合、90kHz の3刻みとして扱う
+ */
+typedef struct {
+    intmax_t value;         //!< 数値
+    chrono_ratio_t period;  //!< 倍率
+} chrono_tick_t;
+
+
+/*!
+  倍率 r から倍率 to への変換器.
+  除算を逆数の乗算に置き換えておく
+ */
+typedef struct {
+    uint64_t num;    //!< 約分した乗数
+    uint64_t den;    //!< 約分した除数
+    uint64_t magic;  //!< den の逆数
+    uint8_t shift1;  //!< 逆数の補正シフト
+    uint8_t shift2;  //!< 逆数の補正シフト
+} chrono_ratio_conv_t;
+
+
+/*!
+  有理数倍率を初期化する.
+*/
+#define ChronoRatioInit(n, d) (chrono_ratio_t){ (n), (d) }
+
+
+/*!
+  有理数倍率の期間を初期化する.
+*/
+#define ChronoTickInit(v, n, d) (chrono_tick_t){ (v), { (n), (d) } }
+
+
+/*!
+  時間倍率 cp を有理数倍率 r に変換する.
+ */
+extern void ChronoRatioFromPeriod(chrono_period_t cp, chrono_ratio_t * r);
+
+
+/*!
+  有理数倍率 r を時間倍率 cp に変換する.
+  時間倍率で表せない場合は false を返す
+ */
+extern bool ChronoRatioToPeriod(chrono_ratio_t const * r, chrono_period_t * cp);
+
+
+/*!
+  期間 t を倍率 r に変換して取得する.
+  指定した倍率よりも小さい位は、切り捨てられる. 桁溢れする場合は飽和する
+ */
+extern intmax_t ChronoTickGet(chrono_tick_t const * t, chrono_ratio_t const * r);
+
+
+/*!
+  期間 t に期間 rhs を加算する.
+  倍率は両者を誤差なく表せる倍率になる. 桁溢れする場合は false を返し、t を変更しない
+ */
+extern bool ChronoTickAdd(chrono_tick_t * t, chrono_tick_t const * rhs);
+
+
+/*!
+  期間 t から期間 rhs を減算する.
+  倍率は両者を誤差なく表せる倍率になる. 桁溢れする場合は false を返し、t を変更しない
+ */
+extern bool ChronoTickSub(chrono_tick_t * t, chrono_tick_t const * rhs);
+
+
+/*!
+  期間 t1 が小さいと <0, t1 が大きいと 0< を返す.
+ */
+extern int ChronoTickComp(chrono_tick_t const * t1, chrono_tick_t const * t2);
+
+
+/*!
+  期間 c を期間 t に誤差なく変換する.
+ */
+extern void ChronoTickFromChrono(chrono_t const * c, chrono_tick_t * t);
+
+
+/*!
+  期間 t を期間 c に変換する.
+  倍率を時間倍率で表せない場合はナノ秒に変換し、誤差が出た場合は false を返す
+ */
+extern bool ChronoTickToChrono(chrono_tick_t const * t, chrono_t * c);
+
+
+/*!
+  倍率 from から倍率 to への変換器 rc を初期化する.
+ */
+extern bool ChronoRatioConvInit(chrono_ratio_conv_t * rc, chrono_ratio_t const * from, chrono_ratio_t const * to);
+
+
+/*!
+  変換器 rc で value を変換する.
+  小さい位は、切り捨てられる. 桁溢れする場合は飽和する
+ */
+extern intmax_t ChronoRatioConv(chrono_ratio_conv_t const * rc, intmax_t value);
+
+
+/*!
+  変換器 rc で n 個の src[] を dst[] に変換する.
+ */
+extern void ChronoRatioConvArray(chrono_ratio_conv_t const * rc, intmax_t const * src, intmax_t * dst, size_t n);
+
+#endif // CHRONO_RATIO_H
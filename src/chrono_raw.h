@@ -0,0 +1,27 @@
+/*! @file
+  Chrono : 生モノトニック時間モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+*/
+
+#ifndef CHRONO_RAW_H
+#define CHRONO_RAW_H
+
+#include "chrono_time_point.h"
+
+/*!
+  生モノトニック時刻.
+  CLOCK_MONOTONIC_RAW を用いる. NTP による速度調整(slew)を受けない.
+ */
+#if !defined(CLOCK_MONOTONIC_RAW)
+# error "Undeclared CLOCK_MONOTONIC_RAW"
+#endif
+typedef struct {
+    struct timespec time_point;
+} chrono_raw_t;
+
+CHRONO_TIME_POINT_DECLARE(chrono_raw_t, Raw)
+
+#endif // CHRONO_RAW_H
@@ -0,0 +1,75 @@
+/*! @file
+  Chrono : 資源使用量の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // RUSAGE_THREAD
+#endif
+#include "chrono_rusage.h"
+
+static void rusageFromVal(struct timeval const * tv, chrono_t * c)
+{
+    *c = ChronoInit((intmax_t)tv->tv_sec * -chrono_microseconds + tv->tv_usec, chrono_microseconds);
+}
+
+static void rusageSub(chrono_t const * c1, chrono_t const * c2, chrono_t * c)
+{
+    *c = ChronoInit(ChronoGet(c1, chrono_microseconds) - ChronoGet(c2, chrono_microseconds), chrono_microseconds);
+}
+
+/*!
+  count を経過時間 ns (ナノ秒)あたり per に換算する.
+ */
+static intmax_t rusageRate(intmax_t count, intmax_t ns, intmax_t per)
+{
+    if (ns <= 0)
+        return 0;
+    return (intmax_t)((__int128)count * per / ns);
+}
+
+bool ChronoRusageNow(chrono_rusage_t * ru, chrono_rusage_who_t who)
+{
+    struct rusage usage;
+#if defined(RUSAGE_THREAD)
+    int id = (who == chrono_rusage_thread) ? RUSAGE_THREAD : RUSAGE_SELF;
+#else
+    if (who == chrono_rusage_thread)
+        return false;
+    int id = RUSAGE_SELF;
+#endif
+    if (getrusage(id, &usage) != 0 || !ChronoMnoNow(&ru->time_point))
+        return false;
+
+    rusageFromVal(&usage.ru_utime, &ru->user);
+    rusageFromVal(&usage.ru_stime, &ru->system);
+    ru->nvcsw = usage.ru_nvcsw;
+    ru->nivcsw = usage.ru_nivcsw;
+    ru->minflt = usage.ru_minflt;
+    ru->majflt = usage.ru_majflt;
+    ru->maxrss = usage.ru_maxrss;
+    return true;
+}
+
+void ChronoRusageDiff(chrono_rusage_t const * ru1, chrono_rusage_t const * ru2, chrono_rusage_diff_t * d)
+{
+    ChronoMnoDiff(&ru2->time_point, &ru1->time_point, &d->elapsed);
+    rusageSub(&ru2->user, &ru1->user, &d->user);
+    rusageSub(&ru2->system, &ru1->system, &d->system);
+    d->nvcsw = ru2->nvcsw - ru1->nvcsw;
+    d->nivcsw = ru2->nivcsw - ru1->nivcsw;
+    d->minflt = ru2->minflt - ru1->minflt;
+    d->majflt = ru2->majflt - ru1->majflt;
+    d->maxrss = ru2->maxrss - ru1->maxrss;
+
+    intmax_t ns = ChronoGet(&d->elapsed, chrono_nanoseconds);
+    d->user_permille = rusageRate(ChronoGet(&d->user, chrono_nanoseconds), ns, 1000);
+    d->system_permille = rusageRate(ChronoGet(&d->system, chrono_nanoseconds), ns, 1000);
+    d->nvcsw_rate = rusageRate(d->nvcsw, ns, -chrono_nanoseconds);
+    d->nivcsw_rate = rusageRate(d->nivcsw, ns, -chrono_nanoseconds);
+    d->minflt_rate = rusageRate(d->minflt, ns, -chrono_nanoseconds);
+    d->majflt_rate = rusageRate(d->majflt, ns, -chrono_nanoseconds);
+}
@@ -0,0 +1,76 @@
+/*! @file
+  Chrono : 資源使用量モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  getrusage() の値をモノトニック時刻と一緒に取得する.
+  2つのスナップショットの差から、遅延の原因が CPU、スケジューリング、ページングのいずれかを切り分ける.
+*/
+
+#ifndef CHRONO_RUSAGE_H
+#define CHRONO_RUSAGE_H
+
+#include "chrono_mno.h"
+#include <sys/resource.h>
+
+/*!
+  取得対象.
+ */
+typedef enum {
+    chrono_rusage_self,    //!< プロセス全体 (RUSAGE_SELF)
+    chrono_rusage_thread,  //!< 呼び出したスレッド (RUSAGE_THREAD)
+} chrono_rusage_who_t;
+
+
+/*!
+  資源使用量のスナップショット.
+ */
+typedef struct {
+    chrono_mno_t time_point;  //!< 取得したモノトニック時刻
+    chrono_t user;            //!< ユーザーCPU時間
+    chrono_t system;          //!< システムCPU時間
+    intmax_t nvcsw;           //!< 自発的コンテキストスイッチ回数
+    intmax_t nivcsw;          //!< 非自発的コンテキストスイッチ回数
+    intmax_t minflt;          //!< マイナーページフォルト回数
+    intmax_t majflt;          //!< メジャーページフォルト回数
+    intmax_t maxrss;          //!< 最大常駐セットサイズ(KB)
+} chrono_rusage_t;
+
+
+/*!
+  資源使用量の差.
+  レートは経過時間 elapsed あたりに換算した値
+ */
+typedef struct {
+    chrono_t elapsed;         //!< 経過時間
+    chrono_t user;            //!< ユーザーCPU時間
+    chrono_t system;          //!< システムCPU時間
+    intmax_t nvcsw;           //!< 自発的コンテキストスイッチ回数
+    intmax_t nivcsw;          //!< 非自発的コンテキストスイッチ回数
+    intmax_t minflt;          //!< マイナーページフォルト回数
+    intmax_t majflt;          //!< メジャーページフォルト回数
+    intmax_t maxrss;          //!< 最大常駐セットサイズの増加量(KB)
+    intmax_t user_permille;   //!< 経過時間に対するユーザーCPU時間(‰)
+    intmax_t system_permille; //!< 経過時間に対するシステムCPU時間(‰)
+    intmax_t nvcsw_rate;      //!< 1秒あたりの自発的コンテキストスイッチ回数
+    intmax_t nivcsw_rate;     //!< 1秒あたりの非自発的コンテキストスイッチ回数
+    intmax_t minflt_rate;     //!< 1秒あたりのマイナーページフォルト回数
+    intmax_t majflt_rate;     //!< 1秒あたりのメジャーページフォルト回数
+} chrono_rusage_diff_t;
+
+
+/*!
+  現在の資源使用量を ru に設定する.
+ */
+extern bool ChronoRusageNow(chrono_rusage_t * ru, chrono_rusage_who_t who);
+
+
+/*!
+  資源使用量 ru2 - ru1 の差を d に設定する.
+  ru1 が古いスナップショットであること
+ */
+extern void ChronoRusageDiff(chrono_rusage_t const * ru1, chrono_rusage_t const * ru2, chrono_rusage_diff_t * d);
+
+#endif // CHRONO_RUSAGE_H
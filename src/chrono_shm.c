@@ -0,0 +1,192 @@
+/*! @file
+  Chrono : 共有メモリ時計の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_shm.h"
+#include "chrono_pack.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+//! 初期化済みの印
+#define CHRONO_SHM_MAGIC 0x4348524fu
+
+//! 読み出しを諦めるまでの試行回数
+#define CHRONO_SHM_RETRY 64
+
+/*!
+  ページから読み出した値.
+ */
+typedef struct {
+    int64_t mno;
+    int64_t sys;
+    uint64_t tsc;
+    chrono_tsc_t cal;
+} shm_snap_t;
+
+
+static bool shmLoad(chrono_shm_page_t const * page, shm_snap_t * snap)
+{
+    for (int i = 0; i < CHRONO_SHM_RETRY; ++i) {
+        uint32_t seq = atomic_load_explicit(&page->seq, memory_order_acquire);
+        if (seq == 0)
+            return false;  // まだ発行されていない
+        if (seq & 1)
+            continue;
+        snap->mno = atomic_load_explicit(&page->mno, memory_order_relaxed);
+        snap->sys = atomic_load_explicit(&page->sys, memory_order_relaxed);
+        snap->tsc = atomic_load_explicit(&page->tsc, memory_order_relaxed);
+        snap->cal.mult = atomic_load_explicit(&page->mult, memory_order_relaxed);
+        snap->cal.shift = atomic_load_explicit(&page->shift, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&page->seq, memory_order_relaxed) == seq)
+            return true;
+    }
+    return false;  // 発行者が書き込み中に止まった
+}
+
+/*!
+  発行されてからの経過時間(ナノ秒)を elapsed に設定する. 古い場合は false を返す.
+ */
+static bool shmElapsed(chrono_shm_sub_t const * ss, shm_snap_t * snap, int64_t * elapsed)
+{
+    if (!ss->page || !shmLoad(ss->page, snap) || snap->cal.mult == 0)
+        return false;
+    uint64_t now = ChronoTscRead();
+    if (now < snap->tsc)
+        return false;
+
+    chrono_t c;
+    ChronoTscToChrono(&snap->cal, now - snap->tsc, &c);
+    *elapsed = c.value;
+    return *elapsed <= ss->stale;
+}
+
+bool ChronoShmPublisherOpen(chrono_shm_pub_t * sp, char const * name)
+{
+    strncpy(sp->name, name, sizeof(sp->name) - 1);
+    sp->name[sizeof(sp->name) - 1] = '\0';
+    sp->page = NULL;
+
+    // 発行者は 1 つだけにするため、既存の共有メモリは開かない
+    int fd = shm_open(sp->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, sizeof(chrono_shm_page_t)) != 0) {
+        close(fd);
+        shm_unlink(sp->name);
+        return false;
+    }
+    void * addr = mmap(NULL, sizeof(chrono_shm_page_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        shm_unlink(sp->name);
+        return false;
+    }
+
+    sp->page = addr;
+    memset(&sp->tsc, 0, sizeof(sp->tsc));
+    ChronoTscCalibrate(&sp->tsc, NULL);
+    atomic_store_explicit(&sp->page->seq, 0, memory_order_relaxed);
+    atomic_store_explicit(&sp->page->magic, CHRONO_SHM_MAGIC, memory_order_release);
+    return true;
+}
+
+bool ChronoShmPublish(chrono_shm_pub_t * sp)
+{
+    struct timespec m1, s, m2;
+    uint64_t t1 = ChronoTscRead();
+    if (clock_gettime(CLOCK_MONOTONIC, &m1) != 0
+        || clock_gettime(CLOCK_REALTIME, &s) != 0
+        || clock_gettime(CLOCK_MONOTONIC, &m2) != 0)
+        return false;
+    uint64_t t2 = ChronoTscRead();
+
+    int64_t lo, hi, sys;
+    ChronoPackFromTimeSpec(&m1, &lo);
+    ChronoPackFromTimeSpec(&m2, &hi);
+    ChronoPackFromTimeSpec(&s, &sys);
+
+    chrono_shm_page_t * page = sp->page;
+    uint32_t seq = atomic_load_explicit(&page->seq, memory_order_relaxed);
+    atomic_store_explicit(&page->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&page->mno, lo + (hi - lo) / 2, memory_order_relaxed);
+    atomic_store_explicit(&page->sys, sys, memory_order_relaxed);
+    atomic_store_explicit(&page->tsc, t1 + (t2 - t1) / 2, memory_order_relaxed);
+    atomic_store_explicit(&page->mult, sp->tsc.mult, memory_order_relaxed);
+    atomic_store_explicit(&page->shift, sp->tsc.shift, memory_order_relaxed);
+    atomic_store_explicit(&page->seq, seq + 2, memory_order_release);
+    return true;
+}
+
+void ChronoShmPublisherClose(chrono_shm_pub_t * sp)
+{
+    if (sp->page) {
+        munmap(sp->page, sizeof(chrono_shm_page_t));
+        shm_unlink(sp->name);
+        sp->page = NULL;
+    }
+}
+
+bool ChronoShmSubscriberOpen(chrono_shm_sub_t * ss, char const * name, chrono_t const * stale)
+{
+    ss->page = NULL;
+    ss->stale = ChronoGet(stale, chrono_nanoseconds);
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    void * addr = mmap(NULL, sizeof(chrono_shm_page_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+
+    chrono_shm_page_t const * page = addr;
+    if (atomic_load_explicit(&page->magic, memory_order_acquire) != CHRONO_SHM_MAGIC) {
+        munmap(addr, sizeof(chrono_shm_page_t));
+        return false;
+    }
+    ss->page = page;
+    return true;
+}
+
+void ChronoShmSubscriberClose(chrono_shm_sub_t * ss)
+{
+    if (ss->page) {
+        munmap((void *)ss->page, sizeof(chrono_shm_page_t));
+        ss->page = NULL;
+    }
+}
+
+bool ChronoShmIsStale(chrono_shm_sub_t const * ss)
+{
+    shm_snap_t snap;
+    int64_t elapsed;
+    return !shmElapsed(ss, &snap, &elapsed);
+}
+
+bool ChronoShmMnoNow(chrono_shm_sub_t const * ss, chrono_mno_t * cm)
+{
+    shm_snap_t snap;
+    int64_t elapsed;
+    if (!shmElapsed(ss, &snap, &elapsed))
+        return ChronoMnoNow(cm);
+    ChronoPackToTimeSpec(snap.mno + elapsed, &cm->time_point);
+    return true;
+}
+
+bool ChronoShmSysNow(chrono_shm_sub_t const * ss, chrono_sys_t * cs)
+{
+    shm_snap_t snap;
+    int64_t elapsed;
+    if (!shmElapsed(ss, &snap, &elapsed))
+        return ChronoSysNow(cs);
+    ChronoPackToTimeSpec(snap.sys + elapsed, &cs->time_point);
+    return true;
+}
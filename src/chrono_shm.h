@@ -0,0 +1,110 @@
+/*! @file
+  Chrono : 共有メモリ時計モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  発行者(publisher)は、モノトニック時刻とシステム時刻、TSC の較正値を
+  POSIX 共有メモリのページにシーケンスロックで書き込む.
+  購読者(subscriber)は、ページを読み込み専用で割り当て、システムコールなしで時刻を読み出す.
+  発行者が更新を止めた(古くなった)場合は、自プロセスの時計を使う.
+  経過時間は TSC で測るため、不変 TSC がない環境では常に古いとみなされ、
+  購読者は毎回自プロセスの時計(システムコール)を使う.
+*/
+
+#ifndef CHRONO_SHM_H
+#define CHRONO_SHM_H
+
+#include "chrono_sys.h"
+#include "chrono_mno.h"
+#include "chrono_tsc.h"
+#include <stdatomic.h>
+
+/*!
+  共有メモリのページ.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic uint32_t seq;     //!< シーケンス番号(奇数の場合は書き込み中)
+    _Atomic uint32_t magic;   //!< 初期化済みの印
+    _Atomic int64_t mno;      //!< 発行したモノトニック時刻(ナノ秒)
+    _Atomic int64_t sys;      //!< 発行したシステム時刻(ナノ秒)
+    _Atomic uint64_t tsc;     //!< 発行した時点のTSC
+    _Atomic uint64_t mult;    //!< TSC の較正値. 0 の場合は TSC を使わない
+    _Atomic uint32_t shift;   //!< TSC の較正値
+} chrono_shm_page_t;
+
+
+/*!
+  共有メモリ時計の発行者.
+ */
+typedef struct {
+    chrono_shm_page_t * page;  //!< 割り当てたページ
+    chrono_tsc_t tsc;          //!< TSC の較正値
+    char name[64];             //!< 共有メモリの名前
+} chrono_shm_pub_t;
+
+
+/*!
+  共有メモリ時計の購読者.
+ */
+typedef struct {
+    chrono_shm_page_t const * page;  //!< 割り当てたページ
+    int64_t stale;                   //!< 古いと判断する期間(ナノ秒)
+} chrono_shm_sub_t;
+
+
+/*!
+  共有メモリ name を作成し、発行者 sp を初期化する.
+  TSC が使える場合は、ここで較正する.
+  同名の共有メモリが既にある場合は、別の発行者と共有せずに false を返す
+ */
+extern bool ChronoShmPublisherOpen(chrono_shm_pub_t * sp, char const * name);
+
+
+/*!
+  現在の時刻を共有メモリに書き込む.
+ */
+extern bool ChronoShmPublish(chrono_shm_pub_t * sp);
+
+
+/*!
+  発行者 sp を閉じ、共有メモリを削除する.
+ */
+extern void ChronoShmPublisherClose(chrono_shm_pub_t * sp);
+
+
+/*!
+  共有メモリ name を読み込み専用で開き、購読者 ss を初期化する.
+  最後に発行されてから期間 stale を過ぎた場合は、古いと判断する
+ */
+extern bool ChronoShmSubscriberOpen(chrono_shm_sub_t * ss, char const * name, chrono_t const * stale);
+
+
+/*!
+  購読者 ss を閉じる.
+ */
+extern void ChronoShmSubscriberClose(chrono_shm_sub_t * ss);
+
+
+/*!
+  発行された時刻が古いか?
+ */
+extern bool ChronoShmIsStale(chrono_shm_sub_t const * ss);
+
+
+/*!
+  共有メモリから現在のモノトニック時刻を cm に設定する.
+  古い場合は、自プロセスの時計から設定する
+ */
+extern bool ChronoShmMnoNow(chrono_shm_sub_t const * ss, chrono_mno_t * cm);
+
+
+/*!
+  共有メモリから現在のシステム時刻を cs に設定する.
+  古い場合は、自プロセスの時計から設定する
+ */
+extern bool ChronoShmSysNow(chrono_shm_sub_t const * ss, chrono_sys_t * cs);
+
+#endif // CHRONO_SHM_H
@@ -0,0 +1,269 @@
+/*! @file
+  Chrono : 計測統計の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_stat.h"
+#include <string.h>
+
+static double const statProb[chrono_stat_quantiles] = { 0.50, 0.90, 0.99 };
+
+/*!
+  マーカー i の理想位置の増分.
+ */
+static double statIncrement(double p, int i)
+{
+    switch (i) {
+    case 0: return 0;
+    case 1: return p / 2;
+    case 2: return p;
+    case 3: return (1 + p) / 2;
+    default: return 1;
+    }
+}
+
+static void statSort(double * a, int n)
+{
+    for (int i = 1; i < n; ++i) {
+        double x = a[i];
+        int j = i;
+        for (; j > 0 && a[j - 1] > x; --j)
+            a[j] = a[j - 1];
+        a[j] = x;
+    }
+}
+
+static double statParabolic(chrono_stat_p2_t const * m, int i, double d)
+{
+    double const * h = m->height;
+    double const * n = m->pos;
+    return h[i] + d / (n[i + 1] - n[i - 1])
+        * ((n[i] - n[i - 1] + d) * (h[i + 1] - h[i]) / (n[i + 1] - n[i])
+           + (n[i + 1] - n[i] - d) * (h[i] - h[i - 1]) / (n[i] - n[i - 1]));
+}
+
+static double statLinear(chrono_stat_p2_t const * m, int i, int d)
+{
+    double const * h = m->height;
+    double const * n = m->pos;
+    return h[i] + d * (h[i + d] - h[i]) / (n[i + d] - n[i]);
+}
+
+/*!
+  count 件目の標本 x で P² 法のマーカー m を更新する.
+ */
+static void statP2Add(chrono_stat_p2_t * m, double p, int64_t count, double x)
+{
+    if (count <= 5) {
+        m->height[count - 1] = x;
+        if (count == 5) {
+            statSort(m->height, 5);
+            for (int i = 0; i < 5; ++i) {
+                m->pos[i] = i + 1;
+                m->desired[i] = 1 + 4 * statIncrement(p, i);
+            }
+        }
+        return;
+    }
+
+    int k;
+    if (x < m->height[0]) {
+        m->height[0] = x;
+        k = 0;
+    } else if (x >= m->height[4]) {
+        m->height[4] = x;
+        k = 3;
+    } else {
+        for (k = 0; k < 3 && x >= m->height[k + 1]; ++k)
+            ;
+    }
+
+    for (int i = k + 1; i < 5; ++i)
+        m->pos[i] += 1;
+    for (int i = 0; i < 5; ++i)
+        m->desired[i] += statIncrement(p, i);
+
+    for (int i = 1; i < 4; ++i) {
+        double d = m->desired[i] - m->pos[i];
+        if ((d >= 1 && m->pos[i + 1] - m->pos[i] > 1) ||
+            (d <= -1 && m->pos[i - 1] - m->pos[i] < -1)) {
+            int s = (d < 0) ? -1 : 1;
+            double h = statParabolic(m, i, s);
+            if (!(m->height[i - 1] < h && h < m->height[i + 1]))
+                h = statLinear(m, i, s);
+            m->height[i] = h;
+            m->pos[i] += s;
+        }
+    }
+}
+
+static void statAdd(chrono_stat_t * st, int64_t ns)
+{
+    ++st->count;
+    if (st->count == 1 || ns < st->min)
+        st->min = ns;
+    if (st->count == 1 || ns > st->max)
+        st->max = ns;
+
+    double x = (double)ns;
+    double delta = x - st->mean;
+    st->mean += delta / st->count;
+    st->m2 += delta * (x - st->mean);
+
+    for (int q = 0; q < chrono_stat_quantiles; ++q)
+        statP2Add(&st->quantile[q], statProb[q], st->count, x);
+}
+
+/*!
+  非負整数の平方根(切り捨て).
+ */
+static uint64_t statSqrt(uint64_t x)
+{
+    if (x < 2)
+        return x;
+    uint64_t r = x, y = (x >> 1) + 1;
+    while (y < r) {
+        r = y;
+        y = (r + x / r) >> 1;
+    }
+    return r;
+}
+
+void ChronoStatInit(chrono_stat_t * st)
+{
+    memset(st, 0, sizeof(*st));
+}
+
+void ChronoStatAdd(chrono_stat_t * st, chrono_t const * c)
+{
+    statAdd(st, ChronoGet(c, chrono_nanoseconds));
+}
+
+void ChronoStatAddValue(chrono_stat_t * st, intmax_t value, chrono_period_t period)
+{
+    chrono_t c = ChronoInit(value, period);
+    ChronoStatAdd(st, &c);
+}
+
+bool ChronoStatAddSince(chrono_stat_t * st, chrono_mno_t const * start)
+{
+    chrono_mno_t now;
+    chrono_t c;
+    if (!ChronoMnoNow(&now))
+        return false;
+    ChronoMnoDiff(&now, start, &c);
+    ChronoStatAdd(st, &c);
+    return true;
+}
+
+void ChronoStatMerge(chrono_stat_t * st, chrono_stat_t const * rhs)
+{
+    if (rhs->count == 0)
+        return;
+
+    // 5 件未満なら、標本がそのまま残っているので再投入する
+    if (rhs->count < 5) {
+        for (int64_t i = 0; i < rhs->count; ++i)
+            statAdd(st, (int64_t)rhs->quantile[0].height[i]);
+        return;
+    }
+    if (st->count < 5) {
+        chrono_stat_t tmp = *rhs;
+        for (int64_t i = 0; i < st->count; ++i)
+            statAdd(&tmp, (int64_t)st->quantile[0].height[i]);
+        *st = tmp;
+        return;
+    }
+
+    int64_t n1 = st->count, n2 = rhs->count, n = n1 + n2;
+    double delta = rhs->mean - st->mean;
+    st->mean += delta * n2 / n;
+    st->m2 += rhs->m2 + delta * delta * ((double)n1 * n2 / n);
+    st->count = n;
+    if (rhs->min < st->min)
+        st->min = rhs->min;
+    if (rhs->max > st->max)
+        st->max = rhs->max;
+
+    // マーカーの高さを件数で重み付けし、位置を足し合わせる(近似)
+    for (int q = 0; q < chrono_stat_quantiles; ++q) {
+        chrono_stat_p2_t * m = &st->quantile[q];
+        chrono_stat_p2_t const * r = &rhs->quantile[q];
+        m->height[0] = (double)st->min;
+        m->height[4] = (double)st->max;
+        for (int i = 1; i < 4; ++i) {
+            m->height[i] = (m->height[i] * n1 + r->height[i] * n2) / n;
+            m->pos[i] += r->pos[i];
+        }
+        m->pos[0] = 1;
+        m->pos[4] = (double)n;
+        for (int i = 0; i < 5; ++i)
+            m->desired[i] = 1 + (n - 1) * statIncrement(statProb[q], i);
+    }
+}
+
+int64_t ChronoStatCount(chrono_stat_t const * st)
+{
+    return st->count;
+}
+
+bool ChronoStatMin(chrono_stat_t const * st, chrono_t * c)
+{
+    if (st->count == 0)
+        return false;
+    *c = ChronoInit(st->min, chrono_nanoseconds);
+    return true;
+}
+
+bool ChronoStatMax(chrono_stat_t const * st, chrono_t * c)
+{
+    if (st->count == 0)
+        return false;
+    *c = ChronoInit(st->max, chrono_nanoseconds);
+    return true;
+}
+
+bool ChronoStatMean(chrono_stat_t const * st, chrono_t * c)
+{
+    if (st->count == 0)
+        return false;
+    *c = ChronoInit((intmax_t)(st->mean + (st->mean < 0 ? -0.5 : 0.5)), chrono_nanoseconds);
+    return true;
+}
+
+double ChronoStatVariance(chrono_stat_t const * st)
+{
+    if (st->count < 2)
+        return 0;
+    return st->m2 / (st->count - 1);
+}
+
+bool ChronoStatStddev(chrono_stat_t const * st, chrono_t * c)
+{
+    if (st->count < 2)
+        return false;
+    *c = ChronoInit((intmax_t)statSqrt((uint64_t)ChronoStatVariance(st)), chrono_nanoseconds);
+    return true;
+}
+
+bool ChronoStatQuantile(chrono_stat_t const * st, chrono_stat_quantile_t q, chrono_t * c)
+{
+    if (st->count == 0 || q < 0 || q >= chrono_stat_quantiles)
+        return false;
+
+    double x;
+    if (st->count < 5) {
+        double a[5];
+        int n = (int)st->count;
+        memcpy(a, st->quantile[q].height, sizeof(a));
+        statSort(a, n);
+        x = a[(int)(statProb[q] * (n - 1) + 0.5)];
+    } else {
+        x = st->quantile[q].height[2];
+    }
+    *c = ChronoInit((intmax_t)(x + 0.5), chrono_nanoseconds);
+    return true;
+}
@@ -0,0 +1,129 @@
+/*! @file
+  Chrono : 計測統計モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  ChronoMnoDiff などで得た期間を標本として、件数・最小・最大・平均・分散を
+  Welford 法で、p50/p90/p99 を P² 法で逐次に集計する.
+  標本を保存しないので、1 インスタンスあたりのメモリ量は一定である.
+*/
+
+#ifndef CHRONO_STAT_H
+#define CHRONO_STAT_H
+
+#include "chrono_mno.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoStat"
+#endif
+
+/*!
+  集計する分位点.
+ */
+typedef enum {
+    chrono_stat_p50,  //!< 50 パーセンタイル
+    chrono_stat_p90,  //!< 90 パーセンタイル
+    chrono_stat_p99,  //!< 99 パーセンタイル
+    chrono_stat_quantiles,
+} chrono_stat_quantile_t;
+
+
+/*!
+  P² 法の 5 つのマーカー.
+ */
+typedef struct {
+    double height[5];   //!< マーカーの高さ(ナノ秒)
+    double pos[5];      //!< マーカーの位置
+    double desired[5];  //!< マーカーの理想位置
+} chrono_stat_p2_t;
+
+
+/*!
+  計測統計.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    int64_t count;  //!< 標本数
+    int64_t min;    //!< 最小値(ナノ秒)
+    int64_t max;    //!< 最大値(ナノ秒)
+    double mean;    //!< 平均値(ナノ秒)
+    double m2;      //!< 偏差平方和
+    chrono_stat_p2_t quantile[chrono_stat_quantiles];
+} chrono_stat_t;
+
+
+/*!
+  計測統計 st を初期化する.
+ */
+extern void ChronoStatInit(chrono_stat_t * st);
+
+
+/*!
+  計測統計 st に期間 c を標本として加える.
+ */
+extern void ChronoStatAdd(chrono_stat_t * st, chrono_t const * c);
+
+
+/*!
+  計測統計 st に期間 (value, period) を標本として加える.
+ */
+extern void ChronoStatAddValue(chrono_stat_t * st, intmax_t value, chrono_period_t period);
+
+
+/*!
+  計測統計 st に モノトニック時刻 start から現在までの期間を標本として加える.
+ */
+extern bool ChronoStatAddSince(chrono_stat_t * st, chrono_mno_t const * start);
+
+
+/*!
+  計測統計 st に計測統計 rhs を合算する. スレッド毎の集計をまとめるために使う.
+  件数・最小・最大・平均・分散は正確だが、分位点は近似になる
+ */
+extern void ChronoStatMerge(chrono_stat_t * st, chrono_stat_t const * rhs);
+
+
+/*!
+  計測統計 st の標本数を返す.
+ */
+extern int64_t ChronoStatCount(chrono_stat_t const * st);
+
+
+/*!
+  計測統計 st の最小値を c に設定する. 標本がない場合は false を返す
+ */
+extern bool ChronoStatMin(chrono_stat_t const * st, chrono_t * c);
+
+
+/*!
+  計測統計 st の最大値を c に設定する. 標本がない場合は false を返す
+ */
+extern bool ChronoStatMax(chrono_stat_t const * st, chrono_t * c);
+
+
+/*!
+  計測統計 st の平均値を c に設定する. 標本がない場合は false を返す
+ */
+extern bool ChronoStatMean(chrono_stat_t const * st, chrono_t * c);
+
+
+/*!
+  計測統計 st の分散(ナノ秒の2乗)を返す. 標本が 2 未満の場合は 0 を返す
+ */
+extern double ChronoStatVariance(chrono_stat_t const * st);
+
+
+/*!
+  計測統計 st の標準偏差を c に設定する. 標本が 2 未満の場合は false を返す
+ */
+extern bool ChronoStatStddev(chrono_stat_t const * st, chrono_t * c);
+
+
+/*!
+  計測統計 st の分位点 q の推定値を c に設定する. 標本がない場合は false を返す
+ */
+extern bool ChronoStatQuantile(chrono_stat_t const * st, chrono_stat_quantile_t q, chrono_t * c);
+
+#endif // CHRONO_STAT_H
@@ -0,0 +1,27 @@
+/*! @file
+  Chrono : TAI時間モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+*/
+
+#ifndef CHRONO_TAI_H
+#define CHRONO_TAI_H
+
+#include "chrono_time_point.h"
+
+/*!
+  TAI時刻.
+  CLOCK_TAI を用いる. システム時刻と異なり、閏秒で逆行しない.
+ */
+#if !defined(CLOCK_TAI)
+# error "Undeclared CLOCK_TAI"
+#endif
+typedef struct {
+    struct timespec time_point;
+} chrono_tai_t;
+
+CHRONO_TIME_POINT_DECLARE(chrono_tai_t, Tai)
+
+#endif // CHRONO_TAI_H
@@ -0,0 +1,91 @@
+/*! @file
+  Chrono : 時刻型の雛形
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  clock_gettime() の時計ごとに、独立した時刻型と関数を宣言する.
+  CHRONO_TIME_POINT_DECLARE(chrono_xxx_t, Xxx) は、chrono_mno.h と同じ動作をする以下の関数を宣言する.
+
+  - void ChronoXxxZero(chrono_xxx_t * tp) : 時刻 0 を tp に設定する
+  - void ChronoXxxMin(chrono_xxx_t * tp) : 最小の時刻を tp に設定する
+  - void ChronoXxxMax(chrono_xxx_t * tp) : 最大の時刻を tp に設定する
+  - bool ChronoXxxNow(chrono_xxx_t * tp) : 現在の時刻を tp に設定する
+  - bool ChronoXxxDHMS(chrono_xxx_t * tp, int days, int hours, int minutes, int seconds) : (days, hours, minutes, seconds) を tp に設定する
+  - void ChronoXxxIncr(chrono_xxx_t * tp) : 時刻 tp を最大分解能でインクリメントする
+  - void ChronoXxxDecr(chrono_xxx_t * tp) : 時刻 tp を最大分解能でデクリメントする
+  - bool ChronoXxxAdd(chrono_xxx_t * tp, chrono_t const * c) : 時刻 tp に期間 c を加算する
+  - bool ChronoXxxAddValue(chrono_xxx_t * tp, intmax_t value, chrono_period_t period) : 時刻 tp に期間 (value, period) を加算する
+  - bool ChronoXxxDiff(chrono_xxx_t const * tp1, chrono_xxx_t const * tp2, chrono_t * c) : 時刻 tp1 - tp2 間の時間差(絶対値)を c に設定する
+  - bool ChronoXxxDiffNow(chrono_xxx_t const * tp, chrono_t * c) : 時刻 tp - 現在時刻までの時間差(絶対値)を c に設定する
+  - int ChronoXxxComp(chrono_xxx_t const * tp1, chrono_xxx_t const * tp2) : 時刻 tp1 が小さいと <0, tp1 が大きいと 0< を返す
+  - void ChronoXxxToTimeT(chrono_xxx_t const * tp, time_t * t) : 時刻 tp を time_t に変換する
+  - void ChronoXxxToTimeVal(chrono_xxx_t const * tp, struct timeval * tv) : 時刻 tp を struct timeval に変換する
+  - void ChronoXxxToTimeSpec(chrono_xxx_t const * tp, struct timespec * ts) : 時刻 tp を struct timespec に変換する
+  - int ChronoXxxSleepUntil(chrono_xxx_t const * tp, intmax_t value, chrono_period_t period) : 時刻 tp から期間 (value, period) 経過するまで待つ
+
+  時刻型は、以下のように struct timespec の time_point を持つ構造体とすること.
+
+  @code
+  typedef struct {
+      struct timespec time_point;
+  } chrono_xxx_t;
+  CHRONO_TIME_POINT_DECLARE(chrono_xxx_t, Xxx)
+  @endcode
+
+  関数の実体は chrono.c で CHRONO_TIME_POINT_DEFINE(chrono_xxx_t, Xxx, clock_id) により定義する.
+*/
+
+#ifndef CHRONO_TIME_POINT_H
+#define CHRONO_TIME_POINT_H
+
+#include "chrono.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoTimePoint"
+#endif
+
+#ifndef CHRONO_NO_TIMEVAL
+# define CHRONO_TIME_POINT_DECLARE_TIMEVAL(type, name)                  \
+    extern void Chrono ## name ## ToTimeVal(type const * tp, struct timeval * tv);
+#else
+# define CHRONO_TIME_POINT_DECLARE_TIMEVAL(type, name)
+#endif
+
+#ifndef CHRONO_NO_TIMESPEC
+# define CHRONO_TIME_POINT_DECLARE_TIMESPEC(type, name)                 \
+    extern void Chrono ## name ## ToTimeSpec(type const * tp, struct timespec * ts);
+#else
+# define CHRONO_TIME_POINT_DECLARE_TIMESPEC(type, name)
+#endif
+
+#ifndef CHRONO_NO_ANY_SLEEP
+# define CHRONO_TIME_POINT_DECLARE_SLEEP(type, name)                    \
+    extern int Chrono ## name ## SleepUntil(type const * tp, intmax_t value, chrono_period_t period);
+#else
+# define CHRONO_TIME_POINT_DECLARE_SLEEP(type, name)
+#endif
+
+/*!
+  時刻型 type の関数 Chrono ## name ## Xxx を宣言する.
+ */
+#define CHRONO_TIME_POINT_DECLARE(type, name)                           \
+    extern void Chrono ## name ## Zero(type * tp);                      \
+    extern void Chrono ## name ## Min(type * tp);                       \
+    extern void Chrono ## name ## Max(type * tp);                       \
+    extern bool Chrono ## name ## Now(type * tp);                       \
+    extern bool Chrono ## name ## DHMS(type * tp, int days, int hours, int minutes, int seconds); \
+    extern void Chrono ## name ## Incr(type * tp);                      \
+    extern void Chrono ## name ## Decr(type * tp);                      \
+    extern bool Chrono ## name ## Add(type * tp, chrono_t const * c);   \
+    extern bool Chrono ## name ## AddValue(type * tp, intmax_t value, chrono_period_t period); \
+    extern bool Chrono ## name ## Diff(type const * tp1, type const * tp2, chrono_t * c); \
+    extern bool Chrono ## name ## DiffNow(type const * tp, chrono_t * c); \
+    extern int Chrono ## name ## Comp(type const * tp1, type const * tp2); \
+    extern void Chrono ## name ## ToTimeT(type const * tp, time_t * t); \
+    CHRONO_TIME_POINT_DECLARE_TIMEVAL(type, name)                       \
+    CHRONO_TIME_POINT_DECLARE_TIMESPEC(type, name)                      \
+    CHRONO_TIME_POINT_DECLARE_SLEEP(type, name)
+
+#endif // CHRONO_TIME_POINT_H
@@ -0,0 +1,225 @@
+/*! @file
+  Chrono : タイマー集約の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_timer.h"
+#include <errno.h>
+#include <stdlib.h>
+
+#define TIMER_EARLY 0  // 期限順
+#define TIMER_LATE  1  // 最遅時刻順
+#define TIMER_NONE  UINT32_MAX
+#define TIMER_SLOT_MASK ((UINT32_C(1) << CHRONO_TIMER_SLOT_BITS) - 1)
+#define TIMER_GENERATION_MASK (UINT32_MAX >> (CHRONO_TIMER_SLOT_BITS + 1))  // 識別子を正に保つ
+
+static inline int64_t timerKey(chrono_timer_sched_t const * ts, int h, uint32_t id)
+{
+    chrono_timer_entry_t const * e = &ts->entries[id];
+    return (h == TIMER_EARLY) ? e->deadline : e->latest;
+}
+
+static inline void timerSet(chrono_timer_sched_t * ts, int h, uint32_t i, uint32_t id)
+{
+    ts->heap[h][i] = id;
+    ts->entries[id].pos[h] = i;
+}
+
+static void timerUp(chrono_timer_sched_t * ts, int h, uint32_t i)
+{
+    uint32_t id = ts->heap[h][i];
+    int64_t key = timerKey(ts, h, id);
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (timerKey(ts, h, ts->heap[h][parent]) <= key)
+            break;
+        timerSet(ts, h, i, ts->heap[h][parent]);
+        i = parent;
+    }
+    timerSet(ts, h, i, id);
+}
+
+static void timerDown(chrono_timer_sched_t * ts, int h, uint32_t i)
+{
+    uint32_t id = ts->heap[h][i];
+    int64_t key = timerKey(ts, h, id);
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= ts->count)
+            break;
+        if (child + 1 < ts->count && timerKey(ts, h, ts->heap[h][child + 1]) < timerKey(ts, h, ts->heap[h][child]))
+            ++child;
+        if (key <= timerKey(ts, h, ts->heap[h][child]))
+            break;
+        timerSet(ts, h, i, ts->heap[h][child]);
+        i = child;
+    }
+    timerSet(ts, h, i, id);
+}
+
+/*!
+  ヒープ h の位置 i の要素を取り除く. ts->count は呼び出し側で減らしておくこと
+ */
+static void timerRemoveAt(chrono_timer_sched_t * ts, int h, uint32_t i)
+{
+    uint32_t last = ts->heap[h][ts->count];
+    if (i == ts->count)
+        return;
+    timerSet(ts, h, i, last);
+    if (i > 0 && timerKey(ts, h, last) < timerKey(ts, h, ts->heap[h][(i - 1) / 2]))
+        timerUp(ts, h, i);
+    else
+        timerDown(ts, h, i);
+}
+
+static void timerRemove(chrono_timer_sched_t * ts, uint32_t id)
+{
+    chrono_timer_entry_t * e = &ts->entries[id];
+    --ts->count;
+    timerRemoveAt(ts, TIMER_EARLY, e->pos[TIMER_EARLY]);
+    timerRemoveAt(ts, TIMER_LATE, e->pos[TIMER_LATE]);
+    e->callback = NULL;
+    e->generation = (e->generation + 1) & TIMER_GENERATION_MASK;
+    e->pos[0] = ts->free;
+    e->pos[1] = TIMER_NONE;
+    ts->free = id;
+}
+
+bool ChronoTimerInit(chrono_timer_sched_t * ts, uint32_t capacity)
+{
+    if (capacity > TIMER_SLOT_MASK + 1)
+        return false;
+    ts->entries = calloc(capacity, sizeof(chrono_timer_entry_t));
+    ts->heap[0] = calloc(capacity, sizeof(uint32_t));
+    ts->heap[1] = calloc(capacity, sizeof(uint32_t));
+    if (!ts->entries || !ts->heap[0] || !ts->heap[1]) {
+        ChronoTimerDestroy(ts);
+        return false;
+    }
+    ts->count = 0;
+    ts->capacity = capacity;
+    ts->wakeups = 0;
+    ts->fired = 0;
+    for (uint32_t i = 0; i < capacity; ++i) {
+        ts->entries[i].pos[0] = (i + 1 < capacity) ? i + 1 : TIMER_NONE;
+        ts->entries[i].pos[1] = TIMER_NONE;
+    }
+    ts->free = capacity ? 0 : TIMER_NONE;
+    return true;
+}
+
+void ChronoTimerDestroy(chrono_timer_sched_t * ts)
+{
+    free(ts->entries);
+    free(ts->heap[0]);
+    free(ts->heap[1]);
+    ts->entries = NULL;
+    ts->heap[0] = ts->heap[1] = NULL;
+    ts->count = ts->capacity = 0;
+    ts->free = TIMER_NONE;
+}
+
+int32_t ChronoTimerAdd(chrono_timer_sched_t * ts, chrono_mno_t const * deadline, chrono_t const * slack,
+                       chrono_timer_callback_t callback, void * arg)
+{
+    if (ts->free == TIMER_NONE || callback == NULL)
+        return -1;
+
+    chrono_mno_pack_t p;
+    ChronoMnoPack(deadline, &p);
+    int64_t s = 0;
+    ChronoPackFromChrono(slack, &s);
+    if (s < 0)
+        s = 0;
+
+    uint32_t id = ts->free;
+    chrono_timer_entry_t * e = &ts->entries[id];
+    ts->free = e->pos[0];
+    e->deadline = p.value;
+    e->latest = (p.value > INT64_MAX - s) ? INT64_MAX : p.value + s;
+    e->callback = callback;
+    e->arg = arg;
+
+    uint32_t i = ts->count++;
+    timerSet(ts, TIMER_EARLY, i, id);
+    timerSet(ts, TIMER_LATE, i, id);
+    timerUp(ts, TIMER_EARLY, i);
+    timerUp(ts, TIMER_LATE, i);
+    return (int32_t)(e->generation << CHRONO_TIMER_SLOT_BITS | id);
+}
+
+bool ChronoTimerCancel(chrono_timer_sched_t * ts, int32_t id)
+{
+    if (id < 0)
+        return false;
+    uint32_t slot = (uint32_t)id & TIMER_SLOT_MASK;
+    if (slot >= ts->capacity || ts->entries[slot].callback == NULL
+        || ts->entries[slot].generation != (uint32_t)id >> CHRONO_TIMER_SLOT_BITS)
+        return false;
+    timerRemove(ts, slot);
+    return true;
+}
+
+uint32_t ChronoTimerCount(chrono_timer_sched_t const * ts)
+{
+    return ts->count;
+}
+
+bool ChronoTimerNext(chrono_timer_sched_t const * ts, chrono_mno_t * cm)
+{
+    if (ts->count == 0)
+        return false;
+    chrono_mno_pack_t p = { ts->entries[ts->heap[TIMER_LATE][0]].latest };
+    ChronoMnoUnpack(&p, cm);
+    return true;
+}
+
+uint32_t ChronoTimerExpire(chrono_timer_sched_t * ts, chrono_mno_t const * now)
+{
+    chrono_mno_pack_t p;
+    ChronoMnoPack(now, &p);
+
+    uint32_t n = 0;
+    while (ts->count > 0) {
+        uint32_t id = ts->heap[TIMER_EARLY][0];
+        chrono_timer_entry_t * e = &ts->entries[id];
+        if (e->deadline > p.value)
+            break;
+        chrono_timer_callback_t callback = e->callback;
+        void * arg = e->arg;
+        timerRemove(ts, id);
+        callback(arg);  // コールバック内でタイマーを登録してもよい
+        ++n;
+    }
+    if (n) {
+        ++ts->wakeups;
+        ts->fired += n;
+    }
+    return n;
+}
+
+uint32_t ChronoTimerWait(chrono_timer_sched_t * ts)
+{
+    chrono_mno_t wake, now;
+    if (!ChronoTimerNext(ts, &wake))
+        return 0;
+    struct timespec spec;
+    ChronoMnoToTimeSpec(&wake, &spec);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &spec, NULL) == EINTR)
+        ;
+    ChronoMnoNow(&now);
+    return ChronoTimerExpire(ts, &now);
+}
+
+uint64_t ChronoTimerWakeups(chrono_timer_sched_t const * ts)
+{
+    return ts->wakeups;
+}
+
+uint64_t ChronoTimerFired(chrono_timer_sched_t const * ts)
+{
+    return ts->fired;
+}
@@ -0,0 +1,126 @@
+/*! @file
+  Chrono : タイマー集約モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  各タイマーは期限 deadline と許容する遅れ slack を持ち、[deadline, deadline + slack] の間に発火すればよい.
+  期限順と最遅時刻順の 2 つのヒープを持ち、最も早い最遅時刻に 1 度だけ起床して、
+  その時点で期限を過ぎたタイマーをまとめて発火させることで、起床回数を減らす.
+*/
+
+#ifndef CHRONO_TIMER_H
+#define CHRONO_TIMER_H
+
+#include "chrono_pack.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoTimer"
+#endif
+
+/*!
+  識別子のうち、タイマーの番号に使うビット数. 残りの上位ビットは再利用を見分ける世代に使う
+ */
+#define CHRONO_TIMER_SLOT_BITS 20
+
+
+/*!
+  タイマーの発火時に呼び出される関数.
+ */
+typedef void (*chrono_timer_callback_t)(void * arg);
+
+
+/*!
+  タイマー.
+ */
+typedef struct {
+    int64_t deadline;                  //!< 期限(ナノ秒)
+    int64_t latest;                    //!< 最遅時刻(ナノ秒)
+    chrono_timer_callback_t callback;  //!< コールバック
+    void * arg;                        //!< コールバックの引数
+    uint32_t pos[2];                   //!< 各ヒープ内の位置. 未使用時は pos[0] が次の空きを指す
+    uint32_t generation;               //!< 世代. 発火や取り消しのたびに進む
+} chrono_timer_entry_t;
+
+
+/*!
+  タイマースケジューラ. スレッドセーフではない
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    chrono_timer_entry_t * entries;  //!< タイマー
+    uint32_t * heap[2];              //!< 期限順、最遅時刻順のヒープ
+    uint32_t count;                  //!< 登録数
+    uint32_t capacity;               //!< 最大登録数
+    uint32_t free;                   //!< 空きタイマーの先頭
+    uint64_t wakeups;                //!< 起床回数
+    uint64_t fired;                  //!< 発火回数
+} chrono_timer_sched_t;
+
+
+/*!
+  スケジューラ ts を最大 capacity 個のタイマーで初期化する.
+  capacity は 2 の CHRONO_TIMER_SLOT_BITS 乗まで
+ */
+extern bool ChronoTimerInit(chrono_timer_sched_t * ts, uint32_t capacity);
+
+
+/*!
+  スケジューラ ts を解放する.
+ */
+extern void ChronoTimerDestroy(chrono_timer_sched_t * ts);
+
+
+/*!
+  スケジューラ ts に、期限 deadline から slack の間に発火するタイマーを登録する.
+  タイマーの識別子(世代とタイマーの番号の組)を返す. 空きがない場合は -1 を返す
+ */
+extern int32_t ChronoTimerAdd(chrono_timer_sched_t * ts, chrono_mno_t const * deadline, chrono_t const * slack,
+                              chrono_timer_callback_t callback, void * arg);
+
+
+/*!
+  スケジューラ ts から識別子 id のタイマーを取り消す.
+  発火済み、もしくは取り消し済みの場合は、同じ番号が再利用されていても false を返す
+ */
+extern bool ChronoTimerCancel(chrono_timer_sched_t * ts, int32_t id);
+
+
+/*!
+  スケジューラ ts の登録数を返す.
+ */
+extern uint32_t ChronoTimerCount(chrono_timer_sched_t const * ts);
+
+
+/*!
+  スケジューラ ts の次に起床すべき時刻を cm に設定する. タイマーがない場合は false を返す
+ */
+extern bool ChronoTimerNext(chrono_timer_sched_t const * ts, chrono_mno_t * cm);
+
+
+/*!
+  スケジューラ ts で時刻 now までに期限を過ぎたタイマーをすべて発火させ、その数を返す.
+ */
+extern uint32_t ChronoTimerExpire(chrono_timer_sched_t * ts, chrono_mno_t const * now);
+
+
+/*!
+  スケジューラ ts の次に起床すべき時刻まで clock_nanosleep で待ち、タイマーを発火させる.
+  発火させた数を返す. タイマーがない場合は待たずに 0 を返す
+ */
+extern uint32_t ChronoTimerWait(chrono_timer_sched_t * ts);
+
+
+/*!
+  スケジューラ ts の起床回数を返す.
+ */
+extern uint64_t ChronoTimerWakeups(chrono_timer_sched_t const * ts);
+
+
+/*!
+  スケジューラ ts の発火回数を返す.
+ */
+extern uint64_t ChronoTimerFired(chrono_timer_sched_t const * ts);
+
+#endif // CHRONO_TIMER_H
@@ -0,0 +1,108 @@
+/*! @file
+  Chrono : TSCの実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_tsc.h"
+#include "chrono_pack.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <cpuid.h>
+# include <x86intrin.h>
+# define CHRONO_HAS_TSC
+#endif
+
+static uint64_t tscRead(void)
+{
+#ifdef CHRONO_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int64_t tscScale(chrono_tsc_t const * ct, uint64_t ticks)
+{
+    return (int64_t)(((unsigned __int128)ticks * ct->mult) >> ct->shift);
+}
+
+/*!
+  TSC でモノトニック時刻の読み出しを挟み込み、その中間値を tsc に設定する.
+ */
+static bool tscSample(uint64_t * tsc, int64_t * mno)
+{
+    struct timespec ts;
+    uint64_t t1 = tscRead();
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+        return false;
+    uint64_t t2 = tscRead();
+    *tsc = t1 + (t2 - t1) / 2;
+    ChronoPackFromTimeSpec(&ts, mno);
+    return true;
+}
+
+bool ChronoTscSupported(void)
+{
+#ifdef CHRONO_HAS_TSC
+    unsigned int a, b, c, d;
+    if (!__get_cpuid(0x80000007, &a, &b, &c, &d))
+        return false;
+    return (d & (1 << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+uint64_t ChronoTscRead(void)
+{
+    return tscRead();
+}
+
+bool ChronoTscCalibrate(chrono_tsc_t * ct, chrono_t const * c)
+{
+    if (!ChronoTscSupported())
+        return false;
+
+    chrono_t def = ChronoInit(10, chrono_milliseconds);
+    int64_t wait = ChronoGet((c) ? c : &def, chrono_nanoseconds);
+    uint64_t t1, t2;
+    int64_t m1, m2;
+    if (!tscSample(&t1, &m1))
+        return false;
+    do {
+        if (!tscSample(&t2, &m2))
+            return false;
+    } while (m2 - m1 < wait);
+
+    if (t2 <= t1)
+        return false;
+    ct->shift = 32;
+    ct->mult = (uint64_t)((((unsigned __int128)(m2 - m1)) << ct->shift) / (t2 - t1));
+    ct->tsc = t2;
+    ct->mno = m2;
+    return true;
+}
+
+void ChronoTscToMno(chrono_tsc_t const * ct, uint64_t tsc, chrono_mno_t * cm)
+{
+    int64_t ns = (tsc >= ct->tsc)
+        ? ct->mno + tscScale(ct, tsc - ct->tsc)
+        : ct->mno - tscScale(ct, ct->tsc - tsc);
+    ChronoPackToTimeSpec(ns, &cm->time_point);
+}
+
+void ChronoTscToChrono(chrono_tsc_t const * ct, uint64_t ticks, chrono_t * c)
+{
+    *c = ChronoInit(tscScale(ct, ticks), chrono_nanoseconds);
+}
+
+bool ChronoTscNow(chrono_tsc_t const * ct, chrono_mno_t * cm)
+{
+    if (ct->mult == 0)
+        return ChronoMnoNow(cm);
+    ChronoTscToMno(ct, tscRead(), cm);
+    return true;
+}
@@ -0,0 +1,70 @@
+/*! @file
+  Chrono : TSC(タイムスタンプカウンタ)モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  TSC をモノトニック時刻で較正し、システムコールなしでモノトニック時刻を求める.
+  TSC は x86 で不変(invariant) TSC を持つ場合のみ使用できる.
+*/
+
+#ifndef CHRONO_TSC_H
+#define CHRONO_TSC_H
+
+#include "chrono_mno.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoTsc"
+#endif
+
+
+/*!
+  TSC の較正値.
+  モノトニック時刻(ナノ秒) = mno + ((TSC - tsc) * mult) >> shift
+ */
+typedef struct {
+    uint64_t tsc;    //!< 基準のTSC
+    int64_t mno;     //!< 基準のモノトニック時刻(ナノ秒)
+    uint64_t mult;   //!< 1カウントあたりのナノ秒(固定小数点)
+    uint32_t shift;  //!< mult の小数部のビット数
+} chrono_tsc_t;
+
+
+/*!
+  不変 TSC が使えるか?
+ */
+extern bool ChronoTscSupported(void);
+
+
+/*!
+  TSC を読み出す. 使えない場合は 0 を返す.
+ */
+extern uint64_t ChronoTscRead(void);
+
+
+/*!
+  期間 c の間 TSC とモノトニック時刻を比較して ct を較正する.
+  c が NULL の場合は 10 ミリ秒で較正する.
+ */
+extern bool ChronoTscCalibrate(chrono_tsc_t * ct, chrono_t const * c);
+
+
+/*!
+  TSC の値 tsc を較正値 ct でモノトニック時刻 cm に変換する.
+ */
+extern void ChronoTscToMno(chrono_tsc_t const * ct, uint64_t tsc, chrono_mno_t * cm);
+
+
+/*!
+  TSC の差 ticks を較正値 ct で期間 c に変換する.
+ */
+extern void ChronoTscToChrono(chrono_tsc_t const * ct, uint64_t ticks, chrono_t * c);
+
+
+/*!
+  較正値 ct を使って、現在のモノトニック時刻を cm に設定する.
+ */
+extern bool ChronoTscNow(chrono_tsc_t const * ct, chrono_mno_t * cm);
+
+#endif // CHRONO_TSC_H
@@ -0,0 +1,123 @@
+/*! @file
+  Chrono : 時刻順の一意な識別子の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_uid.h"
+
+/*!
+  既定の epoch (2020-01-01 00:00:00 UTC). 41 ビットのミリ秒で 2089 年まで表せる
+ */
+#define UID_EPOCH (1577836800LL * 1000000000)
+
+static _Atomic uint64_t uidGenerations;
+
+/*!
+  スレッドごとに予約した連番 [next, end) (時刻 << sequence_bits | 連番 の形).
+  1 スレッドで複数の生成器を交互に使うと、そのたびに予約し直す
+ */
+static _Thread_local struct {
+    uint64_t generation;
+    uint64_t next;
+    uint64_t end;
+} uidBlock;
+
+static inline uint64_t uidMask(int bits)
+{
+    return (bits >= 64) ? UINT64_MAX : ((uint64_t)1 << bits) - 1;
+}
+
+/*!
+  現在時刻を 時刻 << sequence_bits の形で返す. epoch より前なら 0
+ */
+static inline uint64_t uidNow(chrono_uid_t const * uid)
+{
+    chrono_sys_pack_t p = { 0 };
+    ChronoSysPackNow(&p);
+    int64_t d = p.value - uid->epoch;
+    return (d > 0) ? (uint64_t)(d / uid->unit) << uid->sequence_bits : 0;
+}
+
+/*!
+  now 以降で、最後に発行した値より後の連番を n 個予約し、先頭を返す.
+ */
+static inline uint64_t uidReserve(chrono_uid_t * uid, uint64_t now, uint64_t n)
+{
+    uint64_t old = atomic_load_explicit(&uid->last, memory_order_relaxed);
+    uint64_t next;
+    do {
+        // 時刻が逆行した場合は、最後の時刻のまま連番を進める
+        next = (now > old) ? now : old + 1;
+    } while (!atomic_compare_exchange_weak_explicit(&uid->last, &old, next + n - 1,
+                                                    memory_order_relaxed, memory_order_relaxed));
+    return next;
+}
+
+static inline uint64_t uidCompose(chrono_uid_t const * uid, uint64_t state)
+{
+    uint64_t time = (state >> uid->sequence_bits) & uidMask(uid->time_bits);
+    uint64_t sequence = state & uidMask(uid->sequence_bits);
+    return (time << (uid->worker_bits + uid->sequence_bits)) | (uid->worker << uid->sequence_bits) | sequence;
+}
+
+bool ChronoUidInit(chrono_uid_t * uid, chrono_sys_t const * epoch, chrono_t const * unit,
+                   int worker_bits, int sequence_bits, uint64_t worker, uint64_t block)
+{
+    chrono_sys_pack_t e = { UID_EPOCH };
+    int64_t u = 1000000;
+    if (worker_bits < 0 || sequence_bits < 0 || worker_bits + sequence_bits > 62)
+        return false;
+    if (worker > uidMask(worker_bits))
+        return false;
+    // 1 単位の連番より多く予約すると、予約が次の時刻にはみ出す
+    if (block > uidMask(sequence_bits) + 1)
+        return false;
+    if (epoch && !ChronoSysPack(epoch, &e))
+        return false;
+    if (unit && (!ChronoPackFromChrono(unit, &u) || u <= 0))
+        return false;
+
+    atomic_init(&uid->last, 0);
+    uid->epoch = e.value;
+    uid->unit = u;
+    uid->time_bits = 63 - worker_bits - sequence_bits;
+    uid->worker_bits = worker_bits;
+    uid->sequence_bits = sequence_bits;
+    uid->worker = worker;
+    uid->block = (block > 1) ? block : 1;
+    uid->generation = atomic_fetch_add(&uidGenerations, 1) + 1;
+    return true;
+}
+
+uint64_t ChronoUidNext(chrono_uid_t * uid)
+{
+    uint64_t now = uidNow(uid);
+    if (uid->block == 1)
+        return uidCompose(uid, uidReserve(uid, now, 1));
+
+    // 予約が残っていて、その時刻が現在時刻に追い越されていなければ使う
+    if (uidBlock.generation == uid->generation && uidBlock.next < uidBlock.end
+        && (uidBlock.next >> uid->sequence_bits) >= (now >> uid->sequence_bits))
+        return uidCompose(uid, uidBlock.next++);
+
+    uint64_t state = uidReserve(uid, now, uid->block);
+    uidBlock.generation = uid->generation;
+    uidBlock.next = state + 1;
+    uidBlock.end = state + uid->block;
+    return uidCompose(uid, state);
+}
+
+void ChronoUidDecode(chrono_uid_t const * uid, uint64_t id, chrono_sys_t * cs, uint64_t * worker, uint64_t * sequence)
+{
+    if (cs) {
+        chrono_sys_pack_t p = { uid->epoch + (int64_t)(id >> (uid->worker_bits + uid->sequence_bits)) * uid->unit };
+        ChronoSysUnpack(&p, cs);
+    }
+    if (worker)
+        *worker = (id >> uid->sequence_bits) & uidMask(uid->worker_bits);
+    if (sequence)
+        *sequence = id & uidMask(uid->sequence_bits);
+}
@@ -0,0 +1,77 @@
+/*! @file
+  Chrono : 時刻順の一意な識別子モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  上位から 時刻 | ワーカー番号 | 連番 を詰めた 63 ビットの識別子 (Snowflake 形式) を発行する.
+  時刻と連番の組 (時刻 << 連番のビット数 | 連番) を 1 つのアトミック変数に持ち、
+  max(最後の値 + 1, 現在時刻 << 連番のビット数) を CAS で書き込む.
+  システム時刻が逆行しても最後の時刻のまま連番を進め、連番があふれると時刻を 1 つ先に進める.
+  スレッドごとに連番をまとめて予約すると、共有変数への CAS は予約ごとに 1 回になる.
+  予約した連番は、時刻が次の単位に進むと捨てるので、識別子の時刻は発行時刻から 1 単位以上遅れない
+*/
+
+#ifndef CHRONO_UID_H
+#define CHRONO_UID_H
+
+#include "chrono_pack.h"
+#include <stdatomic.h>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoUid"
+#endif
+
+/*!
+  ワーカー番号の既定のビット数.
+ */
+#define CHRONO_UID_WORKER_BITS 10
+
+
+/*!
+  連番の既定のビット数.
+ */
+#define CHRONO_UID_SEQUENCE_BITS 12
+
+
+/*!
+  識別子の生成器.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Atomic uint64_t last;    //!< 最後に発行した 時刻 << sequence_bits | 連番
+    int64_t epoch;            //!< 時刻 0 のシステム時刻(ナノ秒)
+    int64_t unit;             //!< 時刻の単位(ナノ秒)
+    int time_bits;            //!< 時刻のビット数
+    int worker_bits;          //!< ワーカー番号のビット数
+    int sequence_bits;        //!< 連番のビット数
+    uint64_t worker;          //!< ワーカー番号
+    uint64_t block;           //!< スレッドごとに予約する連番の数
+    uint64_t generation;      //!< 生成器の世代(スレッドごとの予約の判別用)
+} chrono_uid_t;
+
+
+/*!
+  識別子の生成器 uid を初期化する.
+  時刻は epoch (NULL なら 2020-01-01 UTC) からの unit (NULL なら 1 ミリ秒) 単位で、63 - worker_bits - sequence_bits ビット.
+  block が 2 以上なら、スレッドごとに block 個の連番をまとめて予約する.
+  ビット数やワーカー番号、block (最大 2 の sequence_bits 乗) が範囲外の場合は false を返す
+ */
+extern bool ChronoUidInit(chrono_uid_t * uid, chrono_sys_t const * epoch, chrono_t const * unit,
+                          int worker_bits, int sequence_bits, uint64_t worker, uint64_t block);
+
+
+/*!
+  識別子の生成器 uid から、新しい識別子を発行する.
+  ロックフリーで、複数スレッドから呼び出せる
+ */
+extern uint64_t ChronoUidNext(chrono_uid_t * uid);
+
+
+/*!
+  識別子 id を、時刻 cs, ワーカー番号 worker, 連番 sequence に分解する. 不要な出力は NULL でよい.
+ */
+extern void ChronoUidDecode(chrono_uid_t const * uid, uint64_t id, chrono_sys_t * cs, uint64_t * worker, uint64_t * sequence);
+
+#endif // CHRONO_UID_H
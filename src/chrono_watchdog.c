@@ -0,0 +1,179 @@
+/*! @file
+  Chrono : 停滞監視の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_watchdog.h"
+#include "chrono_pack.h"
+#include <string.h>
+
+static int64_t watchdogNow(clockid_t id)
+{
+    struct timespec ts;
+    int64_t ns;
+    if (clock_gettime(id, &ts) != 0)
+        return -1;
+    ChronoPackFromTimeSpec(&ts, &ns);
+    return ns;
+}
+
+/*!
+  監視スレッドが検出した状態の変化. ロックを外してからコールバックに渡す
+ */
+typedef struct {
+    chrono_watchdog_slot_t const * slot;
+    chrono_watchdog_state_t state;
+    int64_t wall;
+    int64_t cpu;
+} watchdog_event_t;
+
+/*!
+  スレッド slot を調べ、状態が変化していれば ev に書き込んで true を返す. wd->mutex をロックしておくこと
+ */
+static bool watchdogCheck(chrono_watchdog_t * wd, chrono_watchdog_slot_t * slot, int64_t now, watchdog_event_t * ev)
+{
+    uint64_t beat = atomic_load_explicit(&slot->beat, memory_order_relaxed);
+    int64_t cpu = watchdogNow(slot->clock);
+    if (cpu < 0)  // スレッドが終了している
+        return false;
+
+    chrono_watchdog_state_t state;
+    if (beat != slot->seen) {
+        slot->seen = beat;
+        slot->mno = now;
+        slot->cpu = cpu;
+        state = chrono_watchdog_ok;
+    } else if (now - slot->mno < wd->timeout) {
+        state = chrono_watchdog_ok;
+    } else {
+        state = (cpu - slot->cpu < wd->busy) ? chrono_watchdog_stalled : chrono_watchdog_spinning;
+    }
+
+    if (state == atomic_load_explicit(&slot->state, memory_order_relaxed))
+        return false;
+    atomic_store_explicit(&slot->state, state, memory_order_relaxed);
+    *ev = (watchdog_event_t){ slot, state, now - slot->mno, cpu - slot->cpu };
+    return true;
+}
+
+static void * watchdogMain(void * arg)
+{
+    chrono_watchdog_t * wd = arg;
+    int64_t next = watchdogNow(CLOCK_MONOTONIC);
+    watchdog_event_t events[CHRONO_WATCHDOG_THREADS];
+
+    pthread_mutex_lock(&wd->mutex);
+    while (wd->running) {
+        next += wd->interval;
+        struct timespec ts = { next / -chrono_nanoseconds, next % -chrono_nanoseconds };
+        while (wd->running && pthread_cond_timedwait(&wd->cond, &wd->mutex, &ts) == 0)
+            ;
+        if (!wd->running)
+            break;
+
+        int64_t now = watchdogNow(CLOCK_MONOTONIC);
+        int n = 0;
+        for (int i = 0; i < CHRONO_WATCHDOG_THREADS; ++i)
+            if (atomic_load(&wd->slots[i].used) && watchdogCheck(wd, &wd->slots[i], now, &events[n]))
+                ++n;
+        if (next < now)  // 遅れた分は飛ばす
+            next = now;
+
+        if (n && wd->callback) {
+            pthread_mutex_unlock(&wd->mutex);
+            for (int i = 0; i < n; ++i) {
+                chrono_t wall = ChronoInit(events[i].wall, chrono_nanoseconds);
+                chrono_t used = ChronoInit(events[i].cpu, chrono_nanoseconds);
+                wd->callback(wd->arg, events[i].slot, events[i].state, &wall, &used);
+            }
+            pthread_mutex_lock(&wd->mutex);
+        }
+    }
+    pthread_mutex_unlock(&wd->mutex);
+    return NULL;
+}
+
+bool ChronoWatchdogStart(chrono_watchdog_t * wd, chrono_t const * interval, chrono_t const * timeout, chrono_t const * busy,
+                         chrono_watchdog_callback_t callback, void * arg)
+{
+    memset(wd, 0, sizeof(*wd));
+    wd->interval = ChronoGet(interval, chrono_nanoseconds);
+    wd->timeout = ChronoGet(timeout, chrono_nanoseconds);
+    wd->busy = ChronoGet(busy, chrono_nanoseconds);
+    wd->callback = callback;
+    wd->arg = arg;
+    if (wd->interval <= 0)
+        return false;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&wd->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&wd->mutex, NULL);
+
+    wd->running = true;
+    if (pthread_create(&wd->monitor, NULL, watchdogMain, wd) != 0) {
+        wd->running = false;
+        pthread_cond_destroy(&wd->cond);
+        pthread_mutex_destroy(&wd->mutex);
+        return false;
+    }
+    return true;
+}
+
+void ChronoWatchdogStop(chrono_watchdog_t * wd)
+{
+    pthread_mutex_lock(&wd->mutex);
+    if (!wd->running) {
+        pthread_mutex_unlock(&wd->mutex);
+        return;
+    }
+    wd->running = false;
+    pthread_cond_signal(&wd->cond);
+    pthread_mutex_unlock(&wd->mutex);
+
+    pthread_join(wd->monitor, NULL);
+    pthread_cond_destroy(&wd->cond);
+    pthread_mutex_destroy(&wd->mutex);
+}
+
+chrono_watchdog_slot_t * ChronoWatchdogRegister(chrono_watchdog_t * wd, char const * name)
+{
+    clockid_t clock;
+    if (pthread_getcpuclockid(pthread_self(), &clock) != 0)
+        return NULL;
+
+    pthread_mutex_lock(&wd->mutex);
+    chrono_watchdog_slot_t * slot = NULL;
+    for (int i = 0; i < CHRONO_WATCHDOG_THREADS; ++i) {
+        if (!atomic_load(&wd->slots[i].used)) {
+            slot = &wd->slots[i];
+            slot->name = name;
+            slot->clock = clock;
+            slot->seq = 0;
+            atomic_store_explicit(&slot->beat, 0, memory_order_relaxed);
+            slot->seen = 0;
+            slot->mno = watchdogNow(CLOCK_MONOTONIC);
+            slot->cpu = watchdogNow(clock);
+            atomic_store_explicit(&slot->state, chrono_watchdog_ok, memory_order_relaxed);
+            atomic_store(&slot->used, true);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&wd->mutex);
+    return slot;
+}
+
+void ChronoWatchdogUnregister(chrono_watchdog_slot_t * slot)
+{
+    atomic_store(&slot->used, false);
+}
+
+chrono_watchdog_state_t ChronoWatchdogState(chrono_watchdog_slot_t const * slot)
+{
+    return atomic_load_explicit(&slot->state, memory_order_relaxed);
+}
@@ -0,0 +1,140 @@
+/*! @file
+  Chrono : 停滞監視モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  ワーカースレッドはハートビートを打つだけにしておき、
+  監視スレッドが各スレッドの CPU 時間 (pthread_getcpuclockid) とモノトニック時刻を比べる.
+  ハートビートが途絶えた間に CPU 時間が進んでいなければロックや I/O で停止(stalled)、
+  進んでいればビジーループ(spinning)と判定して、コールバックを呼び出す.
+*/
+
+#ifndef CHRONO_WATCHDOG_H
+#define CHRONO_WATCHDOG_H
+
+#include "chrono_mno.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoWatchdog"
+#endif
+
+/*!
+  監視できるスレッドの最大数.
+ */
+#ifndef CHRONO_WATCHDOG_THREADS
+#define CHRONO_WATCHDOG_THREADS 64
+#endif
+
+
+/*!
+  キャッシュラインの大きさ. ハートビートのスロットをこの境界に揃える
+ */
+#ifndef CHRONO_WATCHDOG_CACHE_LINE
+#define CHRONO_WATCHDOG_CACHE_LINE 64
+#endif
+
+
+/*!
+  スレッドの状態.
+ */
+typedef enum {
+    chrono_watchdog_ok,        //!< ハートビートが打たれている
+    chrono_watchdog_stalled,   //!< ハートビートが途絶え、CPU 時間も進んでいない
+    chrono_watchdog_spinning,  //!< ハートビートが途絶え、CPU 時間は進んでいる
+} chrono_watchdog_state_t;
+
+
+/*!
+  監視対象のスレッド.
+  ワーカーが書くハートビートと監視スレッドが書く状態は別のキャッシュラインに置き、隣のスロットとも共有しない.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    _Alignas(CHRONO_WATCHDOG_CACHE_LINE)
+    _Atomic uint64_t beat;                  //!< ハートビートの回数 (ワーカーが書く)
+    uint64_t seq;                           //!< ワーカー側の回数
+    _Alignas(CHRONO_WATCHDOG_CACHE_LINE)
+    _Atomic bool used;                      //!< 使用中か
+    char const * name;                      //!< スレッドの名前
+    clockid_t clock;                        //!< スレッドの CPU 時間クロック
+    uint64_t seen;                          //!< 監視スレッドが最後に見た回数
+    int64_t mno;                            //!< 最後に回数が変化したモノトニック時刻(ナノ秒)
+    int64_t cpu;                            //!< 最後に回数が変化した CPU 時間(ナノ秒)
+    _Atomic chrono_watchdog_state_t state;  //!< 現在の状態
+} chrono_watchdog_slot_t;
+
+
+/*!
+  状態が変化したときに監視スレッドから呼び出される関数.
+  wall はハートビートが途絶えてからの経過時間、cpu はその間の CPU 時間.
+  停滞監視のロックを外して呼び出すので、コールバックの中で登録や解除をしてよい
+ */
+typedef void (*chrono_watchdog_callback_t)(void * arg, chrono_watchdog_slot_t const * slot, chrono_watchdog_state_t state,
+                                           chrono_t const * wall, chrono_t const * cpu);
+
+
+/*!
+  停滞監視.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    chrono_watchdog_slot_t slots[CHRONO_WATCHDOG_THREADS];
+    int64_t interval;                     //!< 監視間隔(ナノ秒)
+    int64_t timeout;                      //!< 途絶えたとみなす時間(ナノ秒)
+    int64_t busy;                         //!< spinning とみなす CPU 時間(ナノ秒)
+    chrono_watchdog_callback_t callback;  //!< コールバック
+    void * arg;                           //!< コールバックの引数
+    pthread_t monitor;                    //!< 監視スレッド
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool running;                         //!< 監視中か
+} chrono_watchdog_t;
+
+
+/*!
+  停滞監視 wd を開始する.
+  interval ごとに調べ、ハートビートが timeout 以上途絶えたスレッドを、
+  その間の CPU 時間が busy 未満なら stalled、busy 以上なら spinning と判定する
+ */
+extern bool ChronoWatchdogStart(chrono_watchdog_t * wd, chrono_t const * interval, chrono_t const * timeout, chrono_t const * busy,
+                                chrono_watchdog_callback_t callback, void * arg);
+
+
+/*!
+  停滞監視 wd を停止する. 監視スレッドの終了を待つ
+ */
+extern void ChronoWatchdogStop(chrono_watchdog_t * wd);
+
+
+/*!
+  呼び出したスレッドを名前 name で停滞監視 wd に登録する.
+  空きがない場合は NULL を返す
+ */
+extern chrono_watchdog_slot_t * ChronoWatchdogRegister(chrono_watchdog_t * wd, char const * name);
+
+
+/*!
+  スレッド slot の登録を解除する.
+ */
+extern void ChronoWatchdogUnregister(chrono_watchdog_slot_t * slot);
+
+
+/*!
+  スレッド slot の状態を返す. どのスレッドから呼び出してもよい
+ */
+extern chrono_watchdog_state_t ChronoWatchdogState(chrono_watchdog_slot_t const * slot);
+
+
+/*!
+  スレッド slot のハートビートを打つ. 登録したスレッドからのみ呼び出すこと
+ */
+static inline void ChronoWatchdogBeat(chrono_watchdog_slot_t * slot)
+{
+    atomic_store_explicit(&slot->beat, ++slot->seq, memory_order_relaxed);
+}
+
+#endif // CHRONO_WATCHDOG_H
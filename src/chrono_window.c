@@ -0,0 +1,226 @@
+/*! @file
+  Chrono : ウィンドウ集計の実体モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+ */
+
+#include "chrono_window.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WINDOW_SUB_BITS 3
+#define WINDOW_SUB (1 << WINDOW_SUB_BITS)
+
+static int64_t windowGcd(int64_t a, int64_t b)
+{
+    while (b) {
+        int64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*!
+  床関数による除算.
+ */
+static inline int64_t windowFloorDiv(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+static inline int windowBucket(int64_t v)
+{
+    if (v < WINDOW_SUB)
+        return (v < 0) ? 0 : (int)v;
+    int e = 63 - __builtin_clzll((uint64_t)v);
+    return (e - WINDOW_SUB_BITS + 1) * WINDOW_SUB + (int)((v >> (e - WINDOW_SUB_BITS)) & (WINDOW_SUB - 1));
+}
+
+/*!
+  バケット b の代表値(範囲の中央).
+ */
+static int64_t windowBucketValue(int b)
+{
+    if (b < WINDOW_SUB)
+        return b;
+    int e = b / WINDOW_SUB + WINDOW_SUB_BITS - 1;
+    int64_t width = (int64_t)1 << (e - WINDOW_SUB_BITS);
+    int64_t low = ((int64_t)1 << e) + (b % WINDOW_SUB) * width;
+    return low + width / 2;
+}
+
+static inline chrono_window_pane_t * windowSlot(chrono_window_t const * w, int64_t k)
+{
+    int64_t i = k % w->size;
+    return &w->ring[(i < 0) ? i + w->size : i];
+}
+
+static void windowResetPane(chrono_window_pane_t * p, int64_t index)
+{
+    p->index = index;
+    p->count = 0;
+    p->sum = 0;
+    p->min = INT64_MAX;
+    p->max = INT64_MIN;
+    memset(p->hist, 0, sizeof(p->hist));
+}
+
+/*!
+  開始ペイン start のウィンドウを集計し、件数があれば出力する.
+ */
+static void windowEmit(chrono_window_t * w, int64_t start)
+{
+    chrono_window_result_t * r = &w->result;
+    r->count = 0;
+    r->sum = 0;
+    r->min = INT64_MAX;
+    r->max = INT64_MIN;
+    memset(r->hist, 0, sizeof(r->hist));
+
+    for (int64_t k = start; k < start + w->window; ++k) {
+        chrono_window_pane_t const * p = windowSlot(w, k);
+        if (p->index != k || p->count == 0)
+            continue;
+        r->count += p->count;
+        r->sum += p->sum;
+        if (p->min < r->min)
+            r->min = p->min;
+        if (p->max > r->max)
+            r->max = p->max;
+        for (int b = 0; b < CHRONO_WINDOW_BUCKETS; ++b)
+            r->hist[b] += p->hist[b];
+    }
+    if (r->count == 0)
+        return;
+
+    chrono_sys_pack_t s = { start * w->pane };
+    chrono_sys_pack_t e = { (start + w->window) * w->pane };
+    ChronoSysUnpack(&s, &r->start);
+    ChronoSysUnpack(&e, &r->end);
+    w->callback(w->arg, r);
+}
+
+/*!
+  終了ペインが end 以下のウィンドウをすべて出力する.
+ */
+static void windowAdvance(chrono_window_t * w, int64_t end)
+{
+    while (w->next + w->window <= end) {
+        if (w->next > w->last) {
+            // 以降のウィンドウは空なので飛ばす
+            int64_t next = (windowFloorDiv(end - w->window, w->slide) + 1) * w->slide;
+            if (next > w->next)
+                w->next = next;
+            break;
+        }
+        windowEmit(w, w->next);
+        w->next += w->slide;
+    }
+}
+
+bool ChronoWindowInit(chrono_window_t * w, chrono_t const * window, chrono_t const * slide, chrono_t const * lateness,
+                      chrono_window_callback_t callback, void * arg)
+{
+    int64_t wn = ChronoGet(window, chrono_nanoseconds);
+    int64_t sn = slide ? ChronoGet(slide, chrono_nanoseconds) : wn;
+    int64_t ln = lateness ? ChronoGet(lateness, chrono_nanoseconds) : 0;
+    if (wn <= 0 || sn <= 0 || sn > wn || ln < 0 || callback == NULL)
+        return false;
+
+    memset(w, 0, sizeof(*w));
+    w->pane = windowGcd(wn, sn);
+    w->window = wn / w->pane;
+    w->slide = sn / w->pane;
+    w->lateness = ln;
+    w->size = w->window + w->slide + (ln + w->pane - 1) / w->pane + 2;
+    w->ring = malloc(sizeof(chrono_window_pane_t) * w->size);
+    if (w->ring == NULL)
+        return false;
+    for (int64_t i = 0; i < w->size; ++i)
+        windowResetPane(&w->ring[i], INT64_MIN);
+    w->callback = callback;
+    w->arg = arg;
+    return true;
+}
+
+void ChronoWindowDestroy(chrono_window_t * w)
+{
+    free(w->ring);
+    w->ring = NULL;
+}
+
+bool ChronoWindowAddPack(chrono_window_t * w, chrono_sys_pack_t const * tp, int64_t value)
+{
+    int64_t t = tp->value;
+    int64_t k = windowFloorDiv(t, w->pane);
+
+    if (!w->started) {
+        // 許容遅延の分だけ前から受け付ける
+        int64_t first = windowFloorDiv(t - w->lateness, w->pane);
+        w->next = (windowFloorDiv(first - w->window, w->slide) + 1) * w->slide;
+        w->latest = t;
+        w->last = k;
+        w->started = true;
+    } else if (t > w->latest) {
+        w->latest = t;
+        windowAdvance(w, windowFloorDiv(t - w->lateness, w->pane));
+    }
+
+    if (k < w->next) {
+        ++w->late;
+        return false;
+    }
+    if (k > w->last)
+        w->last = k;
+
+    chrono_window_pane_t * p = windowSlot(w, k);
+    if (p->index != k)
+        windowResetPane(p, k);
+    p->count += 1;
+    p->sum += value;
+    if (value < p->min)
+        p->min = value;
+    if (value > p->max)
+        p->max = value;
+    p->hist[windowBucket(value)] += 1;
+    return true;
+}
+
+bool ChronoWindowAdd(chrono_window_t * w, chrono_sys_t const * tp, int64_t value)
+{
+    chrono_sys_pack_t p;
+    ChronoSysPack(tp, &p);
+    return ChronoWindowAddPack(w, &p, value);
+}
+
+void ChronoWindowFlush(chrono_window_t * w)
+{
+    if (!w->started)
+        return;
+    windowAdvance(w, w->last + w->window);
+}
+
+uint64_t ChronoWindowLate(chrono_window_t const * w)
+{
+    return w->late;
+}
+
+int64_t ChronoWindowQuantile(chrono_window_result_t const * r, double q)
+{
+    if (r->count == 0)
+        return 0;
+    int64_t rank = (int64_t)(q * (r->count - 1));
+    int64_t seen = 0;
+    for (int b = 0; b < CHRONO_WINDOW_BUCKETS; ++b) {
+        seen += r->hist[b];
+        if (seen > rank) {
+            int64_t v = windowBucketValue(b);
+            return (v < r->min) ? r->min : (v > r->max) ? r->max : v;
+        }
+    }
+    return r->max;
+}
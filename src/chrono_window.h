@@ -0,0 +1,130 @@
+/*! @file
+  Chrono : ウィンドウ集計モジュール
+
+  Copyright (C) 2017 Haruhiko Uchida
+  The software is released under the MIT license.
+  http://opensource.org/licenses/mit-license.php
+
+  システム時刻付きのイベントを、固定長(タンブリング)もしくは重なりのある(スライディング)ウィンドウに分けて、
+  件数・合計・最小・最大と、値の分位点を集計する.
+  ウィンドウとスライドの最大公約数をペインとし、時刻を整数の床関数でペインに割り当てる.
+  ペインはリングに保持し、ウォーターマーク(最大時刻 - 許容遅延)を過ぎたウィンドウをコールバックで出力する.
+  初期化後はイベントごとのメモリ確保をしない
+*/
+
+#ifndef CHRONO_WINDOW_H
+#define CHRONO_WINDOW_H
+
+#include "chrono_pack.h"
+
+#if defined(CHRONO_NO_CLOCK_GETTIME)
+# error "Disabled ChronoWindow"
+#endif
+
+/*!
+  分位点用ヒストグラムのバケット数.
+  2 のべき乗ごとに 8 分割した対数線形のバケットで、相対誤差は 1/16 以下
+ */
+#define CHRONO_WINDOW_BUCKETS 488
+
+
+/*!
+  ペインの集計.
+ */
+typedef struct {
+    int64_t index;                            //!< ペインの番号 (時刻 / ペイン幅)
+    int64_t count;                            //!< 件数
+    int64_t sum;                              //!< 合計
+    int64_t min;                              //!< 最小値
+    int64_t max;                              //!< 最大値
+    uint32_t hist[CHRONO_WINDOW_BUCKETS];     //!< ヒストグラム
+} chrono_window_pane_t;
+
+
+/*!
+  ウィンドウの集計結果.
+ */
+typedef struct {
+    chrono_sys_t start;                       //!< 開始時刻(含む)
+    chrono_sys_t end;                         //!< 終了時刻(含まない)
+    int64_t count;                            //!< 件数
+    int64_t sum;                              //!< 合計
+    int64_t min;                              //!< 最小値
+    int64_t max;                              //!< 最大値
+    uint32_t hist[CHRONO_WINDOW_BUCKETS];     //!< ヒストグラム
+} chrono_window_result_t;
+
+
+/*!
+  ウィンドウが確定したときに呼び出される関数.
+ */
+typedef void (*chrono_window_callback_t)(void * arg, chrono_window_result_t const * r);
+
+
+/*!
+  ウィンドウ集計器.
+  直接メンバを操作せずに、関数を使うこと
+ */
+typedef struct {
+    int64_t pane;                        //!< ペイン幅(ナノ秒)
+    int64_t window;                      //!< ウィンドウ幅(ペイン数)
+    int64_t slide;                       //!< スライド幅(ペイン数)
+    int64_t lateness;                    //!< 許容遅延(ナノ秒)
+    chrono_window_pane_t * ring;         //!< ペインのリング
+    int64_t size;                        //!< リングの大きさ
+    int64_t next;                        //!< 次に出力するウィンドウの開始ペイン
+    int64_t latest;                      //!< 最大のイベント時刻(ナノ秒)
+    int64_t last;                        //!< 最大のペイン番号
+    bool started;                        //!< イベントを受け取ったか
+    uint64_t late;                       //!< 遅れて捨てたイベント数
+    chrono_window_callback_t callback;   //!< コールバック
+    void * arg;                          //!< コールバックの引数
+    chrono_window_result_t result;       //!< 集計結果の作業領域
+} chrono_window_t;
+
+
+/*!
+  ウィンドウ集計器 w を初期化する.
+  ウィンドウ幅 window, スライド幅 slide (NULL ならタンブリング), 許容遅延 lateness (NULL なら 0)
+ */
+extern bool ChronoWindowInit(chrono_window_t * w, chrono_t const * window, chrono_t const * slide, chrono_t const * lateness,
+                             chrono_window_callback_t callback, void * arg);
+
+
+/*!
+  ウィンドウ集計器 w を解放する.
+ */
+extern void ChronoWindowDestroy(chrono_window_t * w);
+
+
+/*!
+  ウィンドウ集計器 w に時刻 tp のイベント(値 value)を加える.
+  出力済みのウィンドウにしか属さない遅れたイベントは捨てて false を返す
+ */
+extern bool ChronoWindowAdd(chrono_window_t * w, chrono_sys_t const * tp, int64_t value);
+
+
+/*!
+  ウィンドウ集計器 w に圧縮時刻 tp のイベント(値 value)を加える.
+ */
+extern bool ChronoWindowAddPack(chrono_window_t * w, chrono_sys_pack_t const * tp, int64_t value);
+
+
+/*!
+  ウィンドウ集計器 w の残りのウィンドウをすべて出力する.
+ */
+extern void ChronoWindowFlush(chrono_window_t * w);
+
+
+/*!
+  ウィンドウ集計器 w で遅れて捨てたイベント数を返す.
+ */
+extern uint64_t ChronoWindowLate(chrono_window_t const * w);
+
+
+/*!
+  集計結果 r の分位点 q (0.0 - 1.0) の推定値を返す.
+ */
+extern int64_t ChronoWindowQuantile(chrono_window_result_t const * r, double q);
+
+#endif // CHRONO_WINDOW_H
@@ -22,6 +22,20 @@ mu_test_case(Get) {
     mu_assert(ChronoGet(&c, 10) == 1);
 }
 
+mu_test_case(GetWide) {
+    // 倍率の積 (時 * ナノ秒 など) が int を超える変換
+    chrono_t c = ChronoInit(2, chrono_hours);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 2LL * 3600 * 1000 * 1000 * 1000);
+    mu_assert(ChronoGet(&c, chrono_microseconds) == 2LL * 3600 * 1000 * 1000);
+
+    c = ChronoInit(1, chrono_days);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 86400LL * 1000 * 1000 * 1000);
+
+    c = ChronoInit(3 * 86400LL * 1000 * 1000 * 1000, chrono_nanoseconds);
+    mu_assert(ChronoGet(&c, chrono_days) == 3);
+    mu_assert(ChronoGet(&c, chrono_hours) == 72);
+}
+
 mu_test_case(Add) {
     chrono_t c = ChronoInit(1, chrono_days);
 
@@ -60,6 +74,50 @@ mu_test_case(Sub) {
     mu_assert(ChronoGet(&c, chrono_milliseconds) == (((24 - 10) * 60 - 100) * 60 - 1000) * 1000 - 101);
 }
 
+mu_test_case(SpecAdd) {
+    // ナノ秒の位の和が ±1 秒をまたぐ加算
+    struct timespec ts = { 10, 900000000 };
+    chrono_t c = ChronoInit(200, chrono_milliseconds);
+    mu_assert(specAdd(&ts, &c));
+    mu_assert(ts.tv_sec == 11 && ts.tv_nsec == 100000000);
+
+    c = ChronoInit(-200, chrono_milliseconds);
+    mu_assert(specAdd(&ts, &c));
+    mu_assert(ts.tv_sec == 10 && ts.tv_nsec == 900000000);
+
+    ts.tv_nsec = 100000000;
+    mu_assert(specAdd(&ts, &c));
+    mu_assert(ts.tv_sec == 9 && ts.tv_nsec == 900000000);
+
+    c = ChronoInit(-1500, chrono_milliseconds);
+    mu_assert(specAdd(&ts, &c));
+    mu_assert(ts.tv_sec == 8 && ts.tv_nsec == 400000000);
+
+    c = ChronoInit(1999999999, chrono_nanoseconds);
+    mu_assert(specAdd(&ts, &c));
+    mu_assert(ts.tv_sec == 10 && ts.tv_nsec == 399999999);
+}
+
+mu_test_case(SpecDiff) {
+    // 秒の差とナノ秒の差の符号が異なる場合
+    struct timespec t1 = { 100, 987655119 }, t2 = { 101, 0 };
+    chrono_t c;
+    mu_assert(specDiff(&t1, &t2, &c));
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 12344881);
+    mu_assert(specDiff(&t2, &t1, &c));
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 12344881);
+
+    t2 = (struct timespec){ 100, 100 };
+    mu_assert(specDiff(&t1, &t2, &c));
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 987655019);
+    mu_assert(specDiff(&t2, &t1, &c));
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 987655019);
+
+    t2 = (struct timespec){ 98, 999999999 };
+    mu_assert(specDiff(&t1, &t2, &c));
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 1987655120);
+}
+
 mu_test_case(ToTimeT) {
     chrono_t c = ChronoInit(12345, chrono_milliseconds);
     time_t t;
@@ -86,8 +144,11 @@ mu_test_case(ToTimeSpec) {
 int main()
 {
     mu_run_test(Get);
+    mu_run_test(GetWide);
     mu_run_test(Add);
     mu_run_test(Sub);
+    mu_run_test(SpecAdd);
+    mu_run_test(SpecDiff);
     mu_run_test(ToTimeT);
     mu_run_test(ToTimeVal);
     mu_run_test(ToTimeSpec);
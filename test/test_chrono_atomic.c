@@ -0,0 +1,108 @@
+#include "chrono.c"
+#include "chrono_atomic.h"
+#include "minunit.h"
+#include <pthread.h>
+
+mu_test_case(StoreLoad) {
+    chrono_mno_t cm1, cm2;
+    chrono_mno_atomic_t a;
+    ChronoMnoNow(&cm1);
+    ChronoMnoAtomicInit(&a, &cm1);
+    ChronoMnoAtomicLoad(&a, &cm2);
+    mu_assert(ChronoMnoComp(&cm1, &cm2) == 0);
+
+    ChronoMnoAddValue(&cm1, 1, chrono_seconds);
+    ChronoMnoAtomicStore(&a, &cm1);
+    ChronoMnoAtomicLoad(&a, &cm2);
+    mu_assert(ChronoMnoComp(&cm1, &cm2) == 0);
+    mu_assert(ChronoMnoAtomicComp(&a, &cm1) == 0);
+}
+
+mu_test_case(FetchMax) {
+    chrono_mno_t cm1, cm2, old;
+    chrono_mno_atomic_t a;
+    ChronoMnoNow(&cm1);
+    ChronoMnoAtomicInit(&a, &cm1);
+
+    cm2 = cm1;
+    ChronoMnoAddValue(&cm2, 10, chrono_milliseconds);
+    mu_assert(ChronoMnoAtomicFetchMax(&a, &cm2, &old));
+    mu_assert(ChronoMnoComp(&old, &cm1) == 0);
+    mu_assert(ChronoMnoAtomicComp(&a, &cm2) == 0);
+
+    // 古い時刻では戻らない
+    mu_assert(!ChronoMnoAtomicFetchMax(&a, &cm1, &old));
+    mu_assert(ChronoMnoComp(&old, &cm2) == 0);
+    mu_assert(ChronoMnoAtomicComp(&a, &cm1) > 0);
+
+    chrono_t c;
+    ChronoMnoAtomicDiff(&a, &cm1, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) == 10);
+}
+
+mu_test_case(CompareExchange) {
+    chrono_mno_t cm1, cm2, expected;
+    chrono_mno_atomic_t a;
+    ChronoMnoNow(&cm1);
+    cm2 = cm1;
+    ChronoMnoAddValue(&cm2, 1, chrono_nanoseconds);
+    ChronoMnoAtomicInit(&a, &cm1);
+
+    expected = cm2;
+    mu_assert(!ChronoMnoAtomicCompareExchange(&a, &expected, &cm2));
+    mu_assert(ChronoMnoComp(&expected, &cm1) == 0);
+    mu_assert(ChronoMnoAtomicCompareExchange(&a, &expected, &cm2));
+    mu_assert(ChronoMnoAtomicComp(&a, &cm2) == 0);
+}
+
+mu_test_case(Touch) {
+    chrono_mno_t zero;
+    chrono_mno_atomic_t a;
+    ChronoMnoZero(&zero);
+    ChronoMnoAtomicInit(&a, &zero);
+    mu_assert(ChronoMnoAtomicTouch(&a));
+    mu_assert(ChronoMnoAtomicComp(&a, &zero) > 0);
+
+    chrono_t c;
+    ChronoMnoAtomicDiffNow(&a, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) < 100);
+}
+
+#define THREADS 4
+#define COUNT 10000
+
+static chrono_mno_atomic_t shared;
+static chrono_mno_pack_t base;
+
+static void * worker(void * arg)
+{
+    int id = (int)(intptr_t)arg;
+    for (int i = 0; i < COUNT; ++i) {
+        chrono_mno_pack_t p = { base.value + i * THREADS + id };
+        ChronoMnoAtomicFetchMaxPack(&shared, &p, NULL);
+    }
+    return NULL;
+}
+
+mu_test_case(Threads) {
+    pthread_t th[THREADS];
+    ChronoMnoPackNow(&base);
+    ChronoMnoAtomicInitPack(&shared, &base);
+    for (int i = 0; i < THREADS; ++i)
+        pthread_create(&th[i], NULL, worker, (void *)(intptr_t)i);
+    for (int i = 0; i < THREADS; ++i)
+        pthread_join(th[i], NULL);
+
+    chrono_mno_pack_t p;
+    ChronoMnoAtomicLoadPack(&shared, &p);
+    mu_assert(p.value == base.value + (COUNT - 1) * THREADS + THREADS - 1);
+}
+
+int main()
+{
+    mu_run_test(StoreLoad);
+    mu_run_test(FetchMax);
+    mu_run_test(CompareExchange);
+    mu_run_test(Touch);
+    mu_run_test(Threads);
+}
@@ -0,0 +1,104 @@
+#include "chrono.c"
+#include "chrono_backoff.c"
+#include "minunit.h"
+
+mu_test_case(Exponential) {
+    chrono_backoff_t bo;
+    chrono_t base = ChronoInit(100, chrono_milliseconds);
+    chrono_t cap = ChronoInit(1, chrono_seconds);
+    chrono_t delays[8];
+    mu_assert(ChronoBackoffInit(&bo, chrono_backoff_exponential, &base, &cap));
+    ChronoBackoffSchedule(&bo, delays, 8);
+    mu_assert(ChronoBackoffAttempts(&bo) == 0);
+
+    static intmax_t const expected[8] = { 100, 200, 400, 800, 1000, 1000, 1000, 1000 };
+    for (int i = 0; i < 8; ++i)
+        mu_assert(ChronoGet(&delays[i], chrono_milliseconds) == expected[i]);
+
+    // 桁あふれしても最大で止まる
+    for (int i = 0; i < 100; ++i)
+        ChronoBackoffNext(&bo, &delays[0]);
+    mu_assert(ChronoGet(&delays[0], chrono_seconds) == 1);
+    mu_assert(ChronoBackoffAttempts(&bo) == 100);
+    ChronoBackoffReset(&bo);
+    ChronoBackoffNext(&bo, &delays[0]);
+    mu_assert(ChronoGet(&delays[0], chrono_milliseconds) == 100);
+
+    mu_assert(!ChronoBackoffInit(&bo, chrono_backoff_exponential, &cap, &base));
+}
+
+mu_test_case(FullJitter) {
+    chrono_backoff_t bo;
+    chrono_t base = ChronoInit(10, chrono_milliseconds);
+    chrono_t cap = ChronoInit(500, chrono_milliseconds);
+    chrono_t d1[16], d2[16];
+    mu_assert(ChronoBackoffInit(&bo, chrono_backoff_full_jitter, &base, &cap));
+
+    ChronoBackoffSeed(42);
+    ChronoBackoffSchedule(&bo, d1, 16);
+    ChronoBackoffSeed(42);
+    ChronoBackoffSchedule(&bo, d2, 16);
+    for (int i = 0; i < 16; ++i) {
+        intmax_t ns = ChronoGet(&d1[i], chrono_nanoseconds);
+        intmax_t limit = (i < 6) ? (10000000LL << i) : 500000000;
+        mu_assert(ns == ChronoGet(&d2[i], chrono_nanoseconds));
+        mu_assert(0 <= ns && ns <= limit);
+    }
+
+    // 平均はおよそ上限の半分
+    intmax_t sum = 0;
+    for (int i = 0; i < 10000; ++i) {
+        chrono_backoff_t tmp = bo;
+        tmp.attempt = 10;
+        ChronoBackoffNext(&tmp, &d1[0]);
+        sum += ChronoGet(&d1[0], chrono_microseconds);
+    }
+    mu_assert(llabs(sum / 10000 - 250000) < 10000);
+}
+
+mu_test_case(Decorrelated) {
+    chrono_backoff_t bo;
+    chrono_t base = ChronoInit(10, chrono_milliseconds);
+    chrono_t cap = ChronoInit(1, chrono_seconds);
+    chrono_t d[64];
+    mu_assert(ChronoBackoffInit(&bo, chrono_backoff_decorrelated, &base, &cap));
+    ChronoBackoffSeed(7);
+    ChronoBackoffSchedule(&bo, d, 64);
+    intmax_t prev = 10000000;
+    bool reached = false;
+    for (int i = 0; i < 64; ++i) {
+        intmax_t ns = ChronoGet(&d[i], chrono_nanoseconds);
+        mu_assert(ns >= 10000000 && ns <= 1000000000);
+        mu_assert(ns <= prev * 3);
+        reached |= (ns == 1000000000);
+        prev = ns;
+    }
+    mu_assert(reached);
+}
+
+mu_test_case(Sleep) {
+    chrono_backoff_t bo;
+    chrono_t base = ChronoInit(5, chrono_milliseconds);
+    chrono_mno_t start, deadline;
+    chrono_t c;
+    ChronoBackoffInit(&bo, chrono_backoff_exponential, &base, &base);
+
+    ChronoMnoNow(&start);
+    mu_assert(ChronoBackoffDeadline(&bo, &deadline));
+    ChronoMnoDiff(&deadline, &start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 5);
+
+    ChronoMnoNow(&start);
+    mu_assert(ChronoBackoffSleep(&bo) == 0);
+    ChronoMnoDiffNow(&start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 5);
+    mu_assert(ChronoBackoffAttempts(&bo) == 2);
+}
+
+int main()
+{
+    mu_run_test(Exponential);
+    mu_run_test(FullJitter);
+    mu_run_test(Decorrelated);
+    mu_run_test(Sleep);
+}
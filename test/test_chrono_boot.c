@@ -0,0 +1,62 @@
+#include "chrono.c"
+#include "minunit.h"
+
+mu_test_case(MinMax) {
+    chrono_boot_t zero, min, max;
+    ChronoBootZero(&zero);
+    ChronoBootMin(&min);
+    ChronoBootMax(&max);
+    mu_assert(ChronoBootComp(&min, &zero) <= 0);
+    mu_assert(ChronoBootComp(&zero, &max) <= 0);
+    mu_assert(ChronoBootComp(&min,  &max) <  0);
+}
+
+mu_test_case(Now) {
+    chrono_boot_t now, min, max;
+    ChronoBootNow(&now);
+    ChronoBootMin(&min);
+    ChronoBootMax(&max);
+    mu_assert(ChronoBootComp(&min, &now) <= 0);
+    mu_assert(ChronoBootComp(&now, &max) <= 0);
+}
+
+mu_test_case(Mno) {
+    // ブートタイムはサスペンド時間を含むので、モノトニック時刻より小さくならない
+    chrono_mno_t cm;
+    chrono_boot_t cb;
+    ChronoMnoNow(&cm);
+    ChronoBootNow(&cb);
+
+    time_t t1, t2;
+    ChronoMnoToTimeT(&cm, &t1);
+    ChronoBootToTimeT(&cb, &t2);
+    mu_assert(t1 <= t2);
+}
+
+mu_test_case(Add) {
+    chrono_boot_t cb1, cb2;
+    ChronoBootNow(&cb1);
+    cb2 = cb1;
+    ChronoBootAddValue(&cb1, 1, chrono_hours);
+    mu_assert(ChronoBootComp(&cb1, &cb2) > 0);
+    ChronoBootAddValue(&cb2, 60, chrono_minutes);
+    mu_assert(ChronoBootComp(&cb1, &cb2) == 0);
+}
+
+mu_test_case(Diff) {
+    chrono_boot_t cb1, cb2;
+    chrono_t c;
+    ChronoBootDHMS(&cb1, 0, 1, 2, 3);
+    ChronoBootDHMS(&cb2, 0, 0, 0, 3);
+    ChronoBootDiff(&cb1, &cb2, &c);
+    mu_assert(ChronoGet(&c, chrono_seconds) == 62 * 60);
+}
+
+int main()
+{
+    mu_run_test(MinMax);
+    mu_run_test(Now);
+    mu_run_test(Mno);
+    mu_run_test(Add);
+    mu_run_test(Diff);
+}
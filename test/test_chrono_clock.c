@@ -0,0 +1,88 @@
+#define _GNU_SOURCE
+#include "chrono.c"
+#include "chrono_tsc.c"
+#include "chrono_clock.c"
+#include "minunit.h"
+
+mu_test_case(Probe) {
+    mu_assert(ChronoClockProbe());
+
+    chrono_clock_info_t info;
+    mu_assert(ChronoClockInfo(chrono_clock_monotonic, &info));
+    mu_assert(info.available);
+    mu_assert(info.source == chrono_clock_monotonic);
+    mu_assert(ChronoGet(&info.resolution, chrono_nanoseconds) > 0);
+    mu_assert(ChronoGet(&info.resolution, chrono_milliseconds) < 1000);
+    mu_assert(ChronoGet(&info.latency, chrono_nanoseconds) >= 0);
+
+    mu_assert(!ChronoClockInfo(chrono_clock_count, &info));
+}
+
+mu_test_case(Select) {
+    chrono_t res = ChronoInit(1, chrono_microseconds);
+    mu_assert(ChronoClockSelect(&res));
+
+    chrono_clock_info_t info;
+    ChronoClockInfo(ChronoClockSelected(), &info);
+    mu_assert(info.available);
+    mu_assert(ChronoGet(&info.resolution, chrono_nanoseconds) <= 1000);
+    mu_assert(info.source != chrono_clock_monotonic_coarse || info.resolution.value <= 1000);
+
+    // どの時計も満たさない要求は選択を変更しない
+    chrono_clock_source_t selected = ChronoClockSelected();
+    res = ChronoInit(0, chrono_nanoseconds);
+    mu_assert(!ChronoClockSelect(&res));
+    mu_assert(ChronoClockSelected() == selected);
+}
+
+mu_test_case(Now) {
+    chrono_t res = ChronoInit(1, chrono_seconds);
+    mu_assert(ChronoClockSelect(&res));
+
+    chrono_clock_t ct1, ct2;
+    mu_assert(ChronoClockNow(&ct1));
+    ChronoSleepForValue(20, chrono_milliseconds);
+    mu_assert(ChronoClockNow(&ct2));
+    mu_assert(ct1.source == ChronoClockSelected() && ct2.source == ct1.source);
+
+    chrono_t diff;
+    mu_assert(ChronoClockDiff(&ct2, &ct1, &diff));
+    mu_assert(ChronoGet(&diff, chrono_milliseconds) >= 10);
+}
+
+mu_test_case(Typed) {
+    chrono_clock_info_t info;
+    chrono_clock_t ct1, ct2;
+    chrono_t diff;
+
+    // BOOTTIME と MONOTONIC_RAW は、それぞれの時刻型で読み出す
+    ChronoClockInfo(chrono_clock_boottime, &info);
+    if (info.available) {
+        ct1.source = chrono_clock_boottime;
+        mu_assert(clockBoottime(&ct1));
+        chrono_boot_t now;
+        ChronoBootNow(&now);
+        mu_assert(ChronoBootComp(&ct1.boot, &now) <= 0);
+    }
+    ChronoClockInfo(chrono_clock_monotonic_raw, &info);
+    if (info.available) {
+        ct2.source = chrono_clock_monotonic_raw;
+        mu_assert(clockMonotonicRaw(&ct2));
+        chrono_raw_t now;
+        ChronoRawNow(&now);
+        mu_assert(ChronoRawComp(&ct2.raw, &now) <= 0);
+    }
+
+    // 異なる時計の値どうしは比較できない
+    ct1.source = chrono_clock_boottime;
+    ct2.source = chrono_clock_monotonic;
+    mu_assert(!ChronoClockDiff(&ct1, &ct2, &diff));
+}
+
+int main()
+{
+    mu_run_test(Probe);
+    mu_run_test(Select);
+    mu_run_test(Now);
+    mu_run_test(Typed);
+}
@@ -0,0 +1,70 @@
+#include "chrono_coro.hpp"
+#include "minunit.h"
+#include <vector>
+
+static std::vector<int> order;
+
+static Chrono::task sleeper(Chrono::executor & ex, int id, Chrono::milliseconds d)
+{
+    co_await ex.sleep_for(d);
+    order.push_back(id);
+}
+
+mu_test_case(Order) {
+    Chrono::executor ex;
+    order.clear();
+    ex.spawn(sleeper(ex, 3, Chrono::milliseconds(30)));
+    ex.spawn(sleeper(ex, 1, Chrono::milliseconds(10)));
+    ex.spawn(sleeper(ex, 2, Chrono::milliseconds(20)));
+    mu_assert(ex.size() == 3);
+
+    Chrono::mno_time start = Chrono::mno_time::now();
+    ex.run();
+    Chrono::nanoseconds elapsed = Chrono::mno_time::now() - start;
+
+    mu_assert(ex.size() == 0);
+    mu_assert(order.size() == 3 && order[0] == 1 && order[1] == 2 && order[2] == 3);
+    mu_assert(elapsed >= Chrono::milliseconds(30));
+    mu_assert(ex.wakeups() <= 3);
+}
+
+static Chrono::task until(Chrono::executor & ex, chrono_mno_t deadline, int & count)
+{
+    co_await ex.sleep_until(deadline);
+    ++count;
+    chrono_t c = ChronoInit(1, chrono_milliseconds);
+    co_await ex.sleep_for(c);
+    co_await ex.sleep_for(std::chrono::microseconds(100));
+    ++count;
+}
+
+mu_test_case(Until) {
+    Chrono::executor ex;
+    int count = 0;
+    chrono_mno_t deadline = Chrono::mno_time::now() + Chrono::milliseconds(10);
+    for (int i = 0; i < 1000; ++i)
+        ex.spawn(until(ex, deadline, count));
+    ex.run();
+    mu_assert(count == 2000);
+    // 同じ期限のコルーチンはまとめて起こされる
+    mu_assert(ex.wakeups() <= 10);
+    mu_assert(Chrono::mno_time::now() >= Chrono::mno_time(deadline));
+}
+
+mu_test_case(Destroy) {
+    int count = 0;
+    {
+        Chrono::executor ex;
+        chrono_mno_t deadline = Chrono::mno_time::now() + Chrono::seconds(10);
+        ex.spawn(until(ex, deadline, count));
+        mu_assert(ex.size() == 1);
+    }
+    mu_assert(count == 0);
+}
+
+int main()
+{
+    mu_run_test(Order);
+    mu_run_test(Until);
+    mu_run_test(Destroy);
+}
@@ -0,0 +1,103 @@
+#include "chrono.c"
+#include "chrono_cron.c"
+#include "minunit.h"
+
+static void utc(int y, int mo, int d, int h, int mi, chrono_sys_t * cs)
+{
+    struct tm tm = { 0 };
+    tm.tm_year = y - 1900;
+    tm.tm_mon = mo - 1;
+    tm.tm_mday = d;
+    tm.tm_hour = h;
+    tm.tm_min = mi;
+    cs->time_point.tv_sec = timegm(&tm);
+    cs->time_point.tv_nsec = 0;
+}
+
+static bool next(char const * expr, int y, int mo, int d, int h, int mi,
+                 int ey, int emo, int ed, int eh, int emi)
+{
+    chrono_cron_t cron;
+    chrono_sys_t after, n, e;
+    if (!ChronoCronParse(&cron, expr))
+        return false;
+    utc(y, mo, d, h, mi, &after);
+    utc(ey, emo, ed, eh, emi, &e);
+    return ChronoCronNext(&cron, &after, &n) && n.time_point.tv_sec == e.time_point.tv_sec
+        && ChronoCronMatch(&cron, &n);
+}
+
+mu_test_case(Parse) {
+    chrono_cron_t cron;
+    mu_assert(ChronoCronParse(&cron, "*/15 9-17 * * MON-FRI"));
+    mu_assert(cron.minute == ((1ULL << 0) | (1ULL << 15) | (1ULL << 30) | (1ULL << 45)));
+    mu_assert(cron.hour == 0x3fe00);
+    mu_assert(cron.mday_any && !cron.wday_any);
+    mu_assert(cron.wday == 0x3e);
+    mu_assert(ChronoCronParse(&cron, "0 0 1,15 jan,jul 7"));
+    mu_assert(cron.month == ((1 << 1) | (1 << 7)) && cron.wday == 1);
+    mu_assert(ChronoCronParse(&cron, "5/20 * * * *"));
+    mu_assert(cron.minute == ((1ULL << 5) | (1ULL << 25) | (1ULL << 45)));
+    mu_assert(ChronoCronParse(&cron, "@daily"));
+
+    mu_assert(!ChronoCronParse(&cron, "60 * * * *"));
+    mu_assert(!ChronoCronParse(&cron, "* * * *"));
+    mu_assert(!ChronoCronParse(&cron, "* * 0 * *"));
+    mu_assert(!ChronoCronParse(&cron, "* * * 13 *"));
+    mu_assert(!ChronoCronParse(&cron, "*/0 * * * *"));
+    mu_assert(!ChronoCronParse(&cron, "5-1 * * * *"));
+    mu_assert(!ChronoCronParse(&cron, "* * * * * *"));
+    mu_assert(!ChronoCronParse(&cron, "* * * FOO *"));
+}
+
+mu_test_case(Next) {
+    mu_assert(next("* * * * *", 2024, 1, 1, 0, 0, 2024, 1, 1, 0, 1));
+    mu_assert(next("0 * * * *", 2024, 1, 1, 0, 0, 2024, 1, 1, 1, 0));
+    mu_assert(next("30 23 31 12 *", 2024, 1, 1, 0, 0, 2024, 12, 31, 23, 30));
+    mu_assert(next("@yearly", 2024, 12, 31, 23, 59, 2025, 1, 1, 0, 0));
+    // 2024-03-01 は金曜日
+    mu_assert(next("0 9 * * MON", 2024, 3, 1, 12, 0, 2024, 3, 4, 9, 0));
+    mu_assert(next("*/15 9-17 * * 1-5", 2024, 3, 1, 17, 50, 2024, 3, 4, 9, 0));
+    // 日と曜日の両方を指定すると、どちらかで発火する
+    mu_assert(next("0 0 13 * 5", 2024, 9, 1, 0, 0, 2024, 9, 6, 0, 0));
+    mu_assert(next("0 0 13 * 5", 2024, 9, 12, 0, 0, 2024, 9, 13, 0, 0));
+    // うるう日
+    mu_assert(next("0 0 29 2 *", 2024, 3, 1, 0, 0, 2028, 2, 29, 0, 0));
+    mu_assert(next("0 0 29 2 *", 2096, 3, 1, 0, 0, 2104, 2, 29, 0, 0));
+    mu_assert(next("0 0 31 * *", 2024, 4, 1, 0, 0, 2024, 5, 31, 0, 0));
+    // 1970 年より前
+    mu_assert(next("0 12 * * SUN", 1969, 12, 24, 0, 0, 1969, 12, 28, 12, 0));
+
+    chrono_cron_t cron;
+    chrono_sys_t after, n;
+    mu_assert(ChronoCronParse(&cron, "0 0 30 2 *"));
+    utc(2024, 1, 1, 0, 0, &after);
+    mu_assert(!ChronoCronNext(&cron, &after, &n));
+}
+
+mu_test_case(Brute) {
+    // 分ごとに調べた結果と比べる
+    static char const * const exprs[] = { "*/7 */5 * * *", "0 0 1-7 * MON", "15 3 */10 1,6 *", "0 12 * * SAT,SUN" };
+    for (size_t i = 0; i < sizeof(exprs) / sizeof(exprs[0]); ++i) {
+        chrono_cron_t cron;
+        chrono_sys_t t, n, m;
+        mu_assert(ChronoCronParse(&cron, exprs[i]));
+        utc(2023, 12, 30, 22, 17, &t);
+        for (int k = 0; k < 20; ++k) {
+            mu_assert(ChronoCronNext(&cron, &t, &n));
+            m = t;
+            do {
+                m.time_point.tv_sec = (m.time_point.tv_sec / 60 + 1) * 60;
+            } while (!ChronoCronMatch(&cron, &m));
+            mu_assert(m.time_point.tv_sec == n.time_point.tv_sec);
+            t = n;
+        }
+    }
+}
+
+int main()
+{
+    mu_run_test(Parse);
+    mu_run_test(Next);
+    mu_run_test(Brute);
+}
@@ -0,0 +1,66 @@
+#include "chrono.c"
+#include "chrono_format.c"
+#include "minunit.h"
+#include <string.h>
+
+static bool format(intmax_t value, chrono_period_t period, int precision, char const * expect)
+{
+    char buf[CHRONO_FORMAT_MAX];
+    chrono_t c = ChronoInit(value, period);
+    size_t n = ChronoFormat(&c, buf, sizeof(buf), precision);
+    return n == strlen(expect) && strcmp(buf, expect) == 0;
+}
+
+static bool unit(intmax_t value, chrono_period_t period, chrono_period_t u, int precision, char const * expect)
+{
+    char buf[CHRONO_FORMAT_MAX];
+    chrono_t c = ChronoInit(value, period);
+    size_t n = ChronoFormatUnit(&c, u, buf, sizeof(buf), precision);
+    return n == strlen(expect) && strcmp(buf, expect) == 0;
+}
+
+mu_test_case(Auto) {
+    mu_assert(format(0, chrono_seconds, 3, "0s"));
+    mu_assert(format(3723004, chrono_milliseconds, 3, "1h02m03.004s"));
+    mu_assert(format(3723004, chrono_milliseconds, 0, "1h02m03s"));
+    mu_assert(format(850, chrono_microseconds, 3, "850\xc2\xb5s"));
+    mu_assert(format(1500, chrono_microseconds, 3, "1.5ms"));
+    mu_assert(format(1234567, chrono_nanoseconds, 2, "1.23ms"));
+    mu_assert(format(999, chrono_nanoseconds, 3, "999ns"));
+    mu_assert(format(59999, chrono_milliseconds, 3, "59.999s"));
+    mu_assert(format(60, chrono_seconds, 3, "1m00s"));
+    mu_assert(format(90061, chrono_seconds, 3, "25h01m01s"));
+    mu_assert(format(-1500, chrono_microseconds, 1, "-1.5ms"));
+    mu_assert(format(1000000001, chrono_nanoseconds, 9, "1.000000001s"));
+    mu_assert(format(1000000001, chrono_nanoseconds, 3, "1s"));
+    mu_assert(format(INTMAX_MIN / 1000000000, chrono_seconds, 9, "-2562047h47m16s"));
+}
+
+mu_test_case(Unit) {
+    mu_assert(unit(1234567, chrono_microseconds, chrono_milliseconds, 3, "1234.567ms"));
+    mu_assert(unit(1234567, chrono_microseconds, chrono_seconds, 2, "1.23s"));
+    mu_assert(unit(90, chrono_seconds, chrono_minutes, 3, "1.5m"));
+    mu_assert(unit(36, chrono_hours, chrono_days, 3, "1.5d"));
+    mu_assert(unit(1, chrono_seconds, chrono_nanoseconds, 3, "1000000000ns"));
+    mu_assert(unit(2, chrono_seconds, chrono_microseconds, 3, "2000000\xc2\xb5s"));
+    mu_assert(unit(20, chrono_minutes, chrono_hours, 4, "0.3333h"));
+    mu_assert(unit(0, chrono_seconds, chrono_hours, 4, "0h"));
+    // 定義されていない単位は文字列にしない
+    mu_assert(unit(1, chrono_seconds, (chrono_period_t)7, 3, ""));
+    mu_assert(unit(-1, chrono_seconds, (chrono_period_t)0, 3, ""));
+}
+
+mu_test_case(Truncate) {
+    char buf[5];
+    chrono_t c = ChronoInit(3723004, chrono_milliseconds);
+    mu_assert(ChronoFormat(&c, buf, sizeof(buf), 3) == 12);
+    mu_assert(strcmp(buf, "1h02") == 0);
+    mu_assert(ChronoFormat(&c, NULL, 0, 3) == 12);
+}
+
+int main()
+{
+    mu_run_test(Auto);
+    mu_run_test(Unit);
+    mu_run_test(Truncate);
+}
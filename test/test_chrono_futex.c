@@ -0,0 +1,121 @@
+#include "chrono.c"
+#include "chrono_futex.c"
+#include "minunit.h"
+#include <pthread.h>
+
+mu_test_case(Wait) {
+    _Atomic uint32_t word = 1;
+    chrono_mno_t start, deadline;
+    chrono_t c, timeout = ChronoInit(20, chrono_milliseconds);
+
+    mu_assert(ChronoFutexWait(&word, 0, NULL) == 0);  // 値が異なるので待たない
+
+    ChronoMnoNow(&start);
+    deadline = start;
+    ChronoMnoAddValue(&deadline, 20, chrono_milliseconds);
+    mu_assert(ChronoFutexWait(&word, 1, &deadline) == ETIMEDOUT);
+    ChronoMnoDiffNow(&start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 20);
+
+    mu_assert(ChronoFutexWaitFor(&word, 1, &timeout) == ETIMEDOUT);
+    mu_assert(ChronoFutexWake(&word, 1) == 0);
+}
+
+static chrono_event_t event;
+
+static void * setter(void * arg)
+{
+    (void)arg;
+    ChronoSleepForValue(10, chrono_milliseconds);
+    ChronoEventSet(&event);
+    return NULL;
+}
+
+mu_test_case(Event) {
+    chrono_t timeout = ChronoInit(5, chrono_milliseconds);
+    ChronoEventInit(&event, false);
+    mu_assert(!ChronoEventIsSet(&event));
+    mu_assert(!ChronoEventWaitFor(&event, &timeout));
+
+    pthread_t th[2];
+    pthread_create(&th[0], NULL, setter, NULL);
+    mu_assert(ChronoEventWait(&event, NULL));
+    pthread_join(th[0], NULL);
+    mu_assert(ChronoEventIsSet(&event));
+    mu_assert(ChronoEventWaitFor(&event, &timeout));
+
+    ChronoEventReset(&event);
+    mu_assert(!ChronoEventIsSet(&event));
+
+    // 不正な期限では待ち続けずに false を返す
+    chrono_mno_t bad;
+    ChronoMnoNow(&bad);
+    bad.time_point.tv_nsec = -1;
+    mu_assert(!ChronoEventWait(&event, &bad));
+}
+
+static chrono_sem_t sem;
+
+static void * poster(void * arg)
+{
+    (void)arg;
+    for (int i = 0; i < 1000; ++i)
+        ChronoSemPost(&sem);
+    return NULL;
+}
+
+mu_test_case(Sem) {
+    chrono_t timeout = ChronoInit(5, chrono_milliseconds);
+    ChronoSemInit(&sem, 1);
+    mu_assert(ChronoSemTryWait(&sem));
+    mu_assert(!ChronoSemTryWait(&sem));
+    mu_assert(!ChronoSemWaitFor(&sem, &timeout));
+
+    pthread_t th;
+    pthread_create(&th, NULL, poster, NULL);
+    for (int i = 0; i < 1000; ++i)
+        mu_assert(ChronoSemWait(&sem, NULL));
+    pthread_join(th, NULL);
+    mu_assert(!ChronoSemTryWait(&sem));
+}
+
+static chrono_latch_t latch;
+
+static void * arriver(void * arg)
+{
+    (void)arg;
+    ChronoSleepForValue(5, chrono_milliseconds);
+    ChronoLatchCountDown(&latch, 1);
+    return NULL;
+}
+
+mu_test_case(Latch) {
+    chrono_t timeout = ChronoInit(1, chrono_milliseconds);
+    ChronoLatchInit(&latch, 3);
+    mu_assert(!ChronoLatchTryWait(&latch));
+    mu_assert(!ChronoLatchWaitFor(&latch, &timeout));
+
+    pthread_t th[3];
+    for (int i = 0; i < 3; ++i)
+        pthread_create(&th[i], NULL, arriver, NULL);
+    mu_assert(ChronoLatchWait(&latch, NULL));
+    for (int i = 0; i < 3; ++i)
+        pthread_join(th[i], NULL);
+    mu_assert(ChronoLatchTryWait(&latch));
+
+    // 計数を超えて減らしても 0 で止まる
+    ChronoLatchInit(&latch, 2);
+    ChronoLatchCountDown(&latch, 5);
+    mu_assert(ChronoLatchTryWait(&latch));
+    ChronoLatchCountDown(&latch, 1);
+    mu_assert(ChronoLatchTryWait(&latch));
+    mu_assert(ChronoLatchWaitFor(&latch, &timeout));
+}
+
+int main()
+{
+    mu_run_test(Wait);
+    mu_run_test(Event);
+    mu_run_test(Sem);
+    mu_run_test(Latch);
+}
@@ -0,0 +1,101 @@
+#include "chrono.c"
+#include "chrono_hlc.h"
+#include "minunit.h"
+#include <pthread.h>
+
+#define THREADS 4
+#define STAMPS 20000
+
+mu_test_case(Now) {
+    chrono_hlc_t hlc;
+    chrono_hlc_stamp_t s1, s2;
+    chrono_sys_t cs1, cs2;
+    ChronoHlcInit(&hlc);
+
+    ChronoSysNow(&cs1);
+    ChronoHlcNow(&hlc, &s1);
+    ChronoHlcNow(&hlc, &s2);
+    mu_assert(ChronoHlcComp(&s1, &s2) < 0);
+    mu_assert(ChronoHlcComp(&s2, &s1) > 0);
+    mu_assert(ChronoHlcComp(&s1, &s1) == 0);
+
+    // 物理時刻はミリ秒に切り捨てたシステム時刻
+    ChronoHlcToSys(&s1, &cs2);
+    chrono_t c;
+    ChronoSysDiff(&cs2, &cs1, &c);
+    mu_assert(llabs(ChronoGet(&c, chrono_milliseconds)) <= 1);
+
+    chrono_hlc_stamp_t s3;
+    mu_assert(ChronoHlcFromSys(&cs2, &s3));
+    mu_assert(ChronoHlcComp(&s3, &s1) <= 0 && ChronoHlcLogical(&s3) == 0);
+}
+
+mu_test_case(Update) {
+    chrono_hlc_t hlc;
+    chrono_hlc_stamp_t local, remote, s;
+    ChronoHlcInit(&hlc);
+    ChronoHlcNow(&hlc, &local);
+
+    // 1 時間先の時計から受信すると、その後のタイムスタンプは論理カウンタで進む
+    remote.value = local.value + ((uint64_t)3600000 << CHRONO_HLC_LOGICAL_BITS) + 5;
+    ChronoHlcUpdate(&hlc, &remote, &s);
+    mu_assert(s.value == remote.value + 1);
+    mu_assert(ChronoHlcLogical(&s) == 6);
+    ChronoHlcNow(&hlc, &local);
+    mu_assert(local.value == remote.value + 2);
+
+    // 古いタイムスタンプを受信しても戻らない
+    remote.value = 1;
+    ChronoHlcUpdate(&hlc, &remote, &s);
+    mu_assert(s.value == local.value + 1);
+
+    // システム時刻が逆行した場合と同じく、最後の値より後を発行する
+    atomic_store(&hlc.last, UINT64_MAX - 10);
+    ChronoHlcNow(&hlc, &s);
+    mu_assert(s.value == UINT64_MAX - 9);
+}
+
+static chrono_hlc_t shared;
+static uint64_t stamps[THREADS][STAMPS];
+
+static void * worker(void * arg)
+{
+    uint64_t * out = arg;
+    chrono_hlc_stamp_t s;
+    for (int i = 0; i < STAMPS; ++i) {
+        ChronoHlcNow(&shared, &s);
+        out[i] = s.value;
+    }
+    return NULL;
+}
+
+static int compare(void const * a, void const * b)
+{
+    uint64_t x = *(uint64_t const *)a, y = *(uint64_t const *)b;
+    return (x > y) - (x < y);
+}
+
+mu_test_case(Threads) {
+    pthread_t th[THREADS];
+    ChronoHlcInit(&shared);
+    for (int i = 0; i < THREADS; ++i)
+        pthread_create(&th[i], NULL, worker, stamps[i]);
+    for (int i = 0; i < THREADS; ++i)
+        pthread_join(th[i], NULL);
+
+    // 各スレッド内で単調増加し、全体で重複しない
+    for (int i = 0; i < THREADS; ++i)
+        for (int j = 1; j < STAMPS; ++j)
+            mu_assert(stamps[i][j - 1] < stamps[i][j]);
+    qsort(stamps, THREADS * STAMPS, sizeof(uint64_t), compare);
+    uint64_t * all = &stamps[0][0];
+    for (int i = 1; i < THREADS * STAMPS; ++i)
+        mu_assert(all[i - 1] != all[i]);
+}
+
+int main()
+{
+    mu_run_test(Now);
+    mu_run_test(Update);
+    mu_run_test(Threads);
+}
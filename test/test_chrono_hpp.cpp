@@ -0,0 +1,108 @@
+#include "chrono.hpp"
+#include "minunit.h"
+
+mu_test_case(Duration) {
+    constexpr Chrono::milliseconds ms = Chrono::seconds(2);
+    static_assert(ms.count() == 2000, "seconds -> milliseconds");
+    static_assert(Chrono::duration_cast<Chrono::seconds>(Chrono::milliseconds(2500)).count() == 2, "truncate");
+    static_assert(Chrono::minutes(1) == Chrono::seconds(60), "compare");
+    static_assert(Chrono::hours(1) > Chrono::minutes(59), "compare");
+    static_assert((Chrono::seconds(1) + Chrono::milliseconds(5)).count() == 1005, "add");
+    static_assert((Chrono::seconds(1) - Chrono::milliseconds(5)).count() == 995, "sub");
+    static_assert(Chrono::seconds(3) / Chrono::milliseconds(500) == 6, "div");
+    static_assert(!std::is_convertible_v<Chrono::milliseconds, Chrono::seconds>, "lossy conversion is explicit");
+
+    Chrono::microseconds us(10);
+    us += Chrono::microseconds(5);
+    us *= 2;
+    mu_assert(us.count() == 30);
+    mu_assert((-us).count() == -30);
+}
+
+mu_test_case(StdDuration) {
+    Chrono::milliseconds ms = std::chrono::seconds(3);
+    mu_assert(ms.count() == 3000);
+
+    std::chrono::microseconds us = Chrono::milliseconds(7);
+    mu_assert(us.count() == 7000);
+
+    std::chrono::duration<double> sec = Chrono::milliseconds(1500);
+    mu_assert(sec.count() == 1.5);
+
+    // 浮動小数点からの変換は明示的に行う
+    static_assert(!std::is_convertible_v<std::chrono::duration<double>, Chrono::milliseconds>, "float is explicit");
+    static_assert(!std::is_convertible_v<std::chrono::duration<double, std::milli>, Chrono::milliseconds>,
+                  "float is explicit");
+    Chrono::milliseconds fms(std::chrono::duration<double>(1.5));
+    mu_assert(fms.count() == 1500);
+}
+
+mu_test_case(ChronoT) {
+    chrono_t c = Chrono::minutes(2);
+    mu_assert(c.value == 2 && c.period == chrono_minutes);
+    mu_assert(ChronoGet(&c, chrono_seconds) == 120);
+
+    chrono_t c2 = ChronoInit(1500, chrono_milliseconds);
+    Chrono::seconds s(c2);
+    mu_assert(s.count() == 1);
+    Chrono::microseconds us(c2);
+    mu_assert(us.count() == 1500000);
+}
+
+mu_test_case(TimePoint) {
+    chrono_mno_t cm;
+    ChronoMnoNow(&cm);
+    Chrono::mno_time tp = cm;
+    chrono_mno_t cm2 = tp;
+    mu_assert(ChronoMnoComp(&cm, &cm2) == 0);
+
+    Chrono::mno_time tp2 = tp + Chrono::milliseconds(1500);
+    ChronoMnoAddValue(&cm, 1500, chrono_milliseconds);
+    cm2 = tp2;
+    mu_assert(ChronoMnoComp(&cm, &cm2) == 0);
+    mu_assert(tp < tp2);
+    mu_assert(tp2 - tp == Chrono::milliseconds(1500));
+    mu_assert(tp2 - Chrono::milliseconds(1500) == tp);
+
+    Chrono::mno_time t1 = Chrono::mno_time::now();
+    Chrono::mno_time t2 = Chrono::mno_time::now();
+    mu_assert(t1 <= t2);
+}
+
+mu_test_case(StdTimePoint) {
+    Chrono::sys_time now = std::chrono::system_clock::now();
+    chrono_sys_t cs;
+    ChronoSysNow(&cs);
+    mu_assert(Chrono::sys_time(cs) - now < Chrono::seconds(1));
+
+    std::chrono::system_clock::time_point stp = now;
+    mu_assert(Chrono::sys_time(stp) == now);
+
+    Chrono::mno_time m1 = Chrono::mno_time::now();
+    std::chrono::steady_clock::time_point s = std::chrono::steady_clock::now();
+    Chrono::mno_time m2 = Chrono::mno_time::now();
+    mu_assert(m1 <= Chrono::mno_time(s));
+    mu_assert(Chrono::mno_time(s) <= m2);
+
+    static_assert(!std::is_convertible_v<Chrono::cpu_time, std::chrono::steady_clock::time_point>, "no std clock");
+
+    // 切り捨てる変換は明示的に行う
+    using std_sec = std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>;
+    using std_dsec = std::chrono::time_point<std::chrono::system_clock, std::chrono::duration<double>>;
+    static_assert(!std::is_convertible_v<Chrono::sys_time, std_sec>, "lossy conversion is explicit");
+    static_assert(std::is_convertible_v<Chrono::sys_time, std_dsec>, "float is implicit");
+    static_assert(!std::is_convertible_v<std_dsec, Chrono::sys_time>, "float is explicit");
+    Chrono::sys_time t(Chrono::nanoseconds(2500000000));
+    mu_assert(static_cast<std_sec>(t).time_since_epoch().count() == 2);
+    mu_assert(Chrono::sys_time(std_dsec(std::chrono::duration<double>(1.5))) == Chrono::sys_time(Chrono::milliseconds(1500)));
+    mu_assert(Chrono::sys_time(std_sec(std::chrono::seconds(2))) == Chrono::sys_time(Chrono::seconds(2)));
+}
+
+int main()
+{
+    mu_run_test(Duration);
+    mu_run_test(StdDuration);
+    mu_run_test(ChronoT);
+    mu_run_test(TimePoint);
+    mu_run_test(StdTimePoint);
+}
@@ -0,0 +1,112 @@
+#include "chrono.c"
+#include "chrono_index.c"
+#include "minunit.h"
+
+#define N 20000
+
+static chrono_sys_pack_t keys[N];
+
+static uint64_t rnd(uint64_t * seed)
+{
+    *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *seed >> 33;
+}
+
+static size_t lower(size_t n, int64_t key)
+{
+    size_t i = 0;
+    while (i < n && keys[i].value < key)
+        ++i;
+    return i;
+}
+
+static size_t upper(size_t n, int64_t key)
+{
+    size_t i = 0;
+    while (i < n && keys[i].value <= key)
+        ++i;
+    return i;
+}
+
+/*!
+  索引の結果を線形探索と比べる.
+ */
+static bool check(size_t n, uint64_t * seed)
+{
+    chrono_index_t ix;
+    static chrono_sys_pack_t q[500];
+    static size_t pos[500];
+    if (!ChronoIndexInit(&ix, keys, n))
+        return false;
+
+    bool ok = true;
+    int64_t lo = n ? keys[0].value - 100 : 0;
+    int64_t span = n ? keys[n - 1].value - keys[0].value + 200 : 1;
+    for (size_t i = 0; i < 500; ++i) {
+        q[i].value = (i % 3 == 0 && n) ? keys[rnd(seed) % n].value : lo + (int64_t)(rnd(seed) % (uint64_t)span);
+        ok &= ChronoIndexLowerBound(&ix, &q[i]) == lower(n, q[i].value);
+        ok &= ChronoIndexUpperBound(&ix, &q[i]) == upper(n, q[i].value);
+    }
+    ChronoIndexLowerBoundBatch(&ix, q, pos, 500);
+    for (size_t i = 0; i < 500; ++i)
+        ok &= pos[i] == lower(n, q[i].value);
+    ChronoIndexDestroy(&ix);
+    return ok;
+}
+
+mu_test_case(Uniform) {
+    chrono_index_t ix;
+    chrono_sys_pack_t a, b;
+    size_t first;
+    uint64_t seed = 1;
+    for (size_t i = 0; i < N; ++i)
+        keys[i].value = 1500000000000000000LL + (int64_t)i * 1000000 + (int64_t)(rnd(&seed) % 1000);
+
+    mu_assert(ChronoIndexInit(&ix, keys, N));
+    mu_assert(ChronoIndexSegments(&ix) <= 2);
+    a.value = keys[100].value;
+    b.value = keys[200].value;
+    mu_assert(ChronoIndexRange(&ix, &a, &b, &first) == 100 && first == 100);
+    mu_assert(ChronoIndexRange(&ix, &b, &a, &first) == 0);
+    a.value = keys[0].value - 1;
+    mu_assert(ChronoIndexLowerBound(&ix, &a) == 0);
+    a.value = keys[N - 1].value;
+    mu_assert(ChronoIndexUpperBound(&ix, &a) == N);
+    a.value = INT64_MAX;
+    mu_assert(ChronoIndexUpperBound(&ix, &a) == N);
+    ChronoIndexDestroy(&ix);
+
+    mu_assert(check(N, &seed));
+    mu_assert(check(1, &seed));
+    mu_assert(check(0, &seed));
+}
+
+mu_test_case(Irregular) {
+    uint64_t seed = 2;
+    // 間隔が大きく変わり、同じ時刻が長く続く列
+    int64_t t = 0;
+    for (size_t i = 0; i < N; ++i) {
+        switch (rnd(&seed) % 4) {
+        case 0: break;
+        case 1: t += (int64_t)(rnd(&seed) % 10); break;
+        case 2: t += (int64_t)(rnd(&seed) % 100000); break;
+        default: t += (i / 1000 % 2) ? 1000 : 0; break;
+        }
+        keys[i].value = t;
+    }
+    mu_assert(check(N, &seed));
+
+    for (size_t i = 0; i < N; ++i)
+        keys[i].value = (i < N / 2) ? 42 : 43;
+    mu_assert(check(N, &seed));
+
+    chrono_index_t ix;
+    keys[10].value = 0;
+    mu_assert(!ChronoIndexInit(&ix, keys, N));
+}
+
+int main()
+{
+    mu_run_test(Uniform);
+    mu_run_test(Irregular);
+}
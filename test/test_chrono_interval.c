@@ -0,0 +1,168 @@
+#include "chrono.c"
+#include "chrono_interval.c"
+#include "minunit.h"
+
+#define N 5000
+
+static chrono_sys_t starts[N], ends[N];
+static uint64_t ids[N];
+static bool alive[N];
+
+static void at(int64_t ns, chrono_sys_t * cs)
+{
+    chrono_sys_pack_t p = { ns };
+    ChronoSysUnpack(&p, cs);
+}
+
+static uint64_t rnd(uint64_t * seed)
+{
+    *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *seed >> 33;
+}
+
+/*!
+  重なる区間を総当たりで数え、識別子の和を sum に設定する.
+ */
+static size_t brute(int64_t st, int64_t en, uint64_t * sum)
+{
+    size_t found = 0;
+    *sum = 0;
+    for (size_t i = 0; i < N; ++i) {
+        chrono_sys_pack_t s, e;
+        ChronoSysPack(&starts[i], &s);
+        ChronoSysPack(&ends[i], &e);
+        if (alive[i] && s.value < en && st < e.value) {
+            ++found;
+            *sum += ids[i];
+        }
+    }
+    return found;
+}
+
+static bool check(chrono_interval_t const * iv, int64_t st, int64_t en)
+{
+    static uint64_t out[N];
+    chrono_sys_t a, b;
+    uint64_t expect, sum = 0;
+    size_t n = brute(st, en, &expect);
+    at(st, &a);
+    at(en, &b);
+    if (ChronoIntervalOverlap(iv, &a, &b, out, N) != n)
+        return false;
+    for (size_t i = 0; i < n; ++i)
+        sum += out[i];
+    return sum == expect;
+}
+
+mu_test_case(Small) {
+    chrono_interval_t iv;
+    chrono_sys_t s[3], e[3], t;
+    uint64_t id[3] = { 10, 20, 30 }, out[4];
+    at(100, &s[0]); at(200, &e[0]);
+    at(150, &s[1]); at(300, &e[1]);
+    at(300, &s[2]); at(400, &e[2]);
+
+    ChronoIntervalInit(&iv);
+    mu_assert(ChronoIntervalStab(&iv, &s[0], out, 4) == 0);
+    mu_assert(ChronoIntervalBuild(&iv, s, e, id, 3));
+    mu_assert(ChronoIntervalCount(&iv) == 3);
+
+    at(99, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 4) == 0);
+    at(100, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 4) == 1 && out[0] == 10);
+    at(199, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 4) == 2);
+    // 終了時刻は含まない
+    at(300, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 4) == 1 && out[0] == 30);
+    // 出力先が足りなくても総数を返す
+    mu_assert(ChronoIntervalOverlap(&iv, &s[0], &e[2], out, 1) == 3);
+
+    mu_assert(ChronoIntervalDelete(&iv, &s[1], &e[1], 20));
+    mu_assert(!ChronoIntervalDelete(&iv, &s[1], &e[1], 20));
+    at(199, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 4) == 1 && out[0] == 10);
+
+    mu_assert(ChronoIntervalInsert(&iv, &s[1], &e[1], 40));
+    mu_assert(!ChronoIntervalInsert(&iv, &e[1], &s[1], 50));
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 4) == 2);
+    mu_assert(ChronoIntervalCount(&iv) == 3);
+    ChronoIntervalDestroy(&iv);
+}
+
+mu_test_case(MaxEnd) {
+    chrono_interval_t iv;
+    chrono_sys_pack_t s, e;
+    chrono_sys_t t;
+    uint64_t id = 7, out[1];
+    s.value = 1000;
+    ChronoSysPackMax(&e);
+
+    ChronoIntervalInit(&iv);
+    mu_assert(ChronoIntervalBuildPack(&iv, &s, &e, &id, 1));
+    at(1000, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 1) == 1 && out[0] == 7);
+    // 圧縮できる最大の時刻でも含まれる
+    at(INT64_MAX / 1000000000 * 1000000000 - 1, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 1) == 1);
+    // 終了時刻 INT64_MAX 自体は含まない
+    at(INT64_MAX, &t);
+    mu_assert(ChronoIntervalStab(&iv, &t, out, 1) == 0);
+    chrono_sys_pack_t last = { INT64_MAX - 1 };
+    mu_assert(ChronoIntervalOverlapPack(&iv, &last, &e, out, 1) == 1);
+    mu_assert(ChronoIntervalOverlapPack(&iv, &e, &e, out, 1) == 0);
+    ChronoIntervalDestroy(&iv);
+}
+
+mu_test_case(Random) {
+    chrono_interval_t iv;
+    uint64_t seed = 1;
+    for (size_t i = 0; i < N; ++i) {
+        int64_t st = (int64_t)(rnd(&seed) % 1000000);
+        int64_t len = (rnd(&seed) % 8 == 0) ? (int64_t)(rnd(&seed) % 200000) + 1 : (int64_t)(rnd(&seed) % 1000) + 1;
+        at(st, &starts[i]);
+        at(st + len, &ends[i]);
+        ids[i] = i + 1;
+        alive[i] = true;
+    }
+    ChronoIntervalInit(&iv);
+    mu_assert(ChronoIntervalBuild(&iv, starts, ends, ids, N / 2));
+    for (size_t i = N / 2; i < N; ++i)
+        alive[i] = false;
+
+    for (int k = 0; k < 200; ++k) {
+        int64_t st = (int64_t)(rnd(&seed) % 1100000) - 50000;
+        mu_assert(check(&iv, st, st + 1));
+        mu_assert(check(&iv, st, st + (int64_t)(rnd(&seed) % 5000) + 1));
+    }
+
+    // 追加と削除を繰り返し、差分バッファの併合と墓標の掃除を起こす
+    for (size_t i = N / 2; i < N; ++i) {
+        mu_assert(ChronoIntervalInsert(&iv, &starts[i], &ends[i], ids[i]));
+        alive[i] = true;
+        size_t j = rnd(&seed) % i;
+        if (alive[j]) {
+            mu_assert(ChronoIntervalDelete(&iv, &starts[j], &ends[j], ids[j]));
+            alive[j] = false;
+        }
+        if (i % 100 == 0) {
+            int64_t st = (int64_t)(rnd(&seed) % 1000000);
+            mu_assert(check(&iv, st, st + 1));
+            mu_assert(check(&iv, st, st + 3000));
+        }
+    }
+    size_t live = 0;
+    for (size_t i = 0; i < N; ++i)
+        live += alive[i];
+    mu_assert(ChronoIntervalCount(&iv) == live);
+    mu_assert(check(&iv, 0, 2000000));
+    ChronoIntervalDestroy(&iv);
+}
+
+int main()
+{
+    mu_run_test(Small);
+    mu_run_test(MaxEnd);
+    mu_run_test(Random);
+}
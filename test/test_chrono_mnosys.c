@@ -0,0 +1,80 @@
+#include "chrono.c"
+#include "chrono_mnosys.c"
+#include "minunit.h"
+
+mu_test_case(Init) {
+    chrono_mnosys_t ms;
+    mu_assert(ChronoMnoSysInit(&ms, NULL));
+    mu_assert(ms.interval == 0);
+
+    chrono_t c;
+    ChronoMnoSysError(&ms, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) >= 0);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) < 10);
+}
+
+mu_test_case(Conv) {
+    chrono_mnosys_t ms;
+    ChronoMnoSysInit(&ms, NULL);
+
+    chrono_mno_t cm;
+    chrono_sys_t cs1, cs2;
+    ChronoMnoNow(&cm);
+    ChronoSysNow(&cs2);
+    ChronoMnoSysConv(&ms, &cm, &cs1);
+
+    chrono_t diff;
+    ChronoSysDiff(&cs1, &cs2, &diff);
+    mu_assert(ChronoGet(&diff, chrono_milliseconds) < 100);
+    mu_assert(ChronoSysComp(&cs1, &cs2) <= 0);
+}
+
+mu_test_case(ConvArray) {
+    chrono_mnosys_t ms;
+    ChronoMnoSysInit(&ms, NULL);
+
+    chrono_mno_t cm[3];
+    chrono_sys_t cs[3], one;
+    ChronoMnoNow(&cm[0]);
+    cm[1] = cm[0];
+    ChronoMnoAddValue(&cm[1], 1, chrono_seconds);
+    cm[2] = cm[0];
+    ChronoMnoAddValue(&cm[2], -1, chrono_seconds);
+    ChronoMnoSysConvArray(&ms, cm, cs, 3);
+
+    for (int i = 0; i < 3; ++i) {
+        ChronoMnoSysConv(&ms, &cm[i], &one);
+        mu_assert(ChronoSysComp(&cs[i], &one) == 0);
+    }
+
+    chrono_t diff;
+    ChronoSysDiff(&cs[1], &cs[0], &diff);
+    mu_assert(ChronoGet(&diff, chrono_seconds) == 1);
+    ChronoSysDiff(&cs[0], &cs[2], &diff);
+    mu_assert(ChronoGet(&diff, chrono_seconds) == 1);
+}
+
+mu_test_case(Resync) {
+    chrono_t interval = ChronoInit(1, chrono_seconds);
+    chrono_mnosys_t ms;
+    ChronoMnoSysInit(&ms, &interval);
+    int64_t synced = ms.synced;
+
+    chrono_mno_t cm;
+    chrono_sys_t cs;
+    ChronoMnoNow(&cm);
+    ChronoMnoSysConv(&ms, &cm, &cs);
+    mu_assert(ms.synced == synced);
+
+    ChronoMnoAddValue(&cm, 2, chrono_seconds);
+    ChronoMnoSysConv(&ms, &cm, &cs);
+    mu_assert(ms.synced != synced);
+}
+
+int main()
+{
+    mu_run_test(Init);
+    mu_run_test(Conv);
+    mu_run_test(ConvArray);
+    mu_run_test(Resync);
+}
@@ -0,0 +1,175 @@
+#include "chrono.c"
+#include "chrono_pack.h"
+#include "minunit.h"
+
+mu_test_case(Size) {
+    mu_assert(sizeof(chrono_sys_pack_t) == 8);
+    mu_assert(sizeof(chrono_mno_pack_t) == 8);
+    mu_assert(sizeof(chrono_cpu_pack_t) == 8);
+}
+
+mu_test_case(MinMax) {
+    chrono_mno_pack_t zero, min, max;
+    ChronoMnoPackZero(&zero);
+    ChronoMnoPackMin(&min);
+    ChronoMnoPackMax(&max);
+    mu_assert(ChronoMnoPackComp(&min, &zero) < 0);
+    mu_assert(ChronoMnoPackComp(&zero, &max) < 0);
+    mu_assert(ChronoMnoPackComp(&max, &max) == 0);
+
+    chrono_t c;
+    mu_assert(!ChronoMnoPackDiff(&min, &max, &c));
+    mu_assert(c.value == INTMAX_MAX);
+}
+
+mu_test_case(PackUnpack) {
+    chrono_sys_t cs1, cs2;
+    chrono_sys_pack_t p;
+    ChronoSysNow(&cs1);
+    mu_assert(ChronoSysPack(&cs1, &p));
+    ChronoSysUnpack(&p, &cs2);
+    mu_assert(ChronoSysComp(&cs1, &cs2) == 0);
+
+    // 負の時刻
+    ChronoSysZero(&cs1);
+    ChronoSysAddValue(&cs1, -1500, chrono_milliseconds);
+    ChronoSysPack(&cs1, &p);
+    mu_assert(p.value == -1500000000);
+    ChronoSysUnpack(&p, &cs2);
+    mu_assert(cs2.time_point.tv_sec == -2);
+    mu_assert(cs2.time_point.tv_nsec == 500000000);
+
+    // 範囲外は飽和する
+    ChronoSysMax(&cs1);
+    mu_assert(!ChronoSysPack(&cs1, &p));
+    mu_assert(p.value == INT64_MAX);
+    ChronoSysMin(&cs1);
+    mu_assert(!ChronoSysPack(&cs1, &p));
+    mu_assert(p.value == INT64_MIN);
+}
+
+mu_test_case(Array) {
+    chrono_mno_t cm[4], out[4];
+    chrono_mno_pack_t p[4];
+    ChronoMnoNow(&cm[0]);
+    for (int i = 1; i < 4; ++i) {
+        cm[i] = cm[i - 1];
+        ChronoMnoAddValue(&cm[i], 1, chrono_microseconds);
+    }
+    mu_assert(ChronoMnoPackArray(cm, p, 4));
+    ChronoMnoUnpackArray(p, out, 4);
+    for (int i = 0; i < 4; ++i)
+        mu_assert(ChronoMnoComp(&cm[i], &out[i]) == 0);
+    for (int i = 1; i < 4; ++i)
+        mu_assert(p[i].value - p[i - 1].value == 1000);
+}
+
+mu_test_case(Comp) {
+    chrono_mno_t cm1, cm2;
+    chrono_mno_pack_t p1, p2;
+    ChronoMnoNow(&cm1);
+    cm2 = cm1;
+    ChronoMnoAddValue(&cm2, 1, chrono_nanoseconds);
+    ChronoMnoPack(&cm1, &p1);
+    ChronoMnoPack(&cm2, &p2);
+    mu_assert(ChronoMnoPackComp(&p1, &p2) == ChronoMnoComp(&cm1, &cm2));
+    mu_assert(ChronoMnoPackComp(&p2, &p1) == ChronoMnoComp(&cm2, &cm1));
+    mu_assert(ChronoMnoPackComp(&p1, &p1) == 0);
+}
+
+mu_test_case(Add) {
+    chrono_mno_pack_t p1, p2;
+    ChronoMnoPackNow(&p1);
+    p2 = p1;
+    mu_assert(ChronoMnoPackAddValue(&p1, 1, chrono_hours));
+    mu_assert(ChronoMnoPackComp(&p1, &p2) > 0);
+    mu_assert(ChronoMnoPackAddValue(&p2, 3600000, chrono_milliseconds));
+    mu_assert(ChronoMnoPackComp(&p1, &p2) == 0);
+    mu_assert(ChronoMnoPackAddValue(&p2, -1, chrono_days));
+    mu_assert(p1.value - p2.value == 86400LL * 1000000000);
+
+    // 桁溢れは飽和する
+    mu_assert(!ChronoMnoPackAddValue(&p1, 1000, chrono_days * 365));
+    mu_assert(p1.value == INT64_MAX);
+}
+
+mu_test_case(Diff) {
+    chrono_mno_t cm1, cm2;
+    chrono_mno_pack_t p1, p2;
+    chrono_t c1, c2;
+    ChronoMnoNow(&cm1);
+    cm2 = cm1;
+    ChronoMnoAddValue(&cm2, 12345, chrono_microseconds);
+    ChronoMnoPack(&cm1, &p1);
+    ChronoMnoPack(&cm2, &p2);
+    ChronoMnoDiff(&cm1, &cm2, &c1);
+    ChronoMnoPackDiff(&p1, &p2, &c2);
+    mu_assert(ChronoGet(&c1, chrono_nanoseconds) == ChronoGet(&c2, chrono_nanoseconds));
+    ChronoMnoPackDiff(&p2, &p1, &c2);
+    mu_assert(ChronoGet(&c2, chrono_nanoseconds) == 12345000);
+}
+
+mu_test_case(DHMS) {
+    chrono_sys_pack_t p;
+    chrono_sys_t cs, cs2;
+    mu_assert(ChronoSysPackDHMS(&p, 1, 2, 3, 4));
+    mu_assert(ChronoSysDHMS(&cs, 1, 2, 3, 4));
+    ChronoSysUnpack(&p, &cs2);
+    mu_assert(ChronoSysComp(&cs, &cs2) == 0);
+    // 範囲外は飽和させる
+    mu_assert(!ChronoSysPackDHMS(&p, 200000, 0, 0, 0));
+    mu_assert(p.value == INT64_MAX);
+}
+
+mu_test_case(IncrDecr) {
+    chrono_mno_pack_t p = { 999999999 };
+    ChronoMnoPackIncr(&p);
+    mu_assert(p.value == 1000000000);
+    ChronoMnoPackDecr(&p);
+    ChronoMnoPackDecr(&p);
+    mu_assert(p.value == 999999998);
+
+    ChronoMnoPackMax(&p);
+    ChronoMnoPackIncr(&p);
+    mu_assert(p.value == INT64_MAX);
+    ChronoMnoPackMin(&p);
+    ChronoMnoPackDecr(&p);
+    mu_assert(p.value == INT64_MIN);
+}
+
+mu_test_case(SleepUntil) {
+    chrono_mno_pack_t p;
+    chrono_t c;
+    ChronoMnoPackNow(&p);
+    mu_assert(ChronoMnoPackSleepUntil(&p, 20, chrono_milliseconds) == 0);
+    ChronoMnoPackDiffNow(&p, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 20);
+}
+
+mu_test_case(ToTime) {
+    chrono_sys_pack_t p = { 12345678901LL };
+    time_t t;
+    struct timeval tv;
+    struct timespec ts;
+    ChronoSysPackToTimeT(&p, &t);
+    ChronoSysPackToTimeVal(&p, &tv);
+    ChronoSysPackToTimeSpec(&p, &ts);
+    mu_assert(t == 12);
+    mu_assert(tv.tv_sec == 12 && tv.tv_usec == 345678);
+    mu_assert(ts.tv_sec == 12 && ts.tv_nsec == 345678901);
+}
+
+int main()
+{
+    mu_run_test(Size);
+    mu_run_test(MinMax);
+    mu_run_test(PackUnpack);
+    mu_run_test(Array);
+    mu_run_test(Comp);
+    mu_run_test(Add);
+    mu_run_test(Diff);
+    mu_run_test(DHMS);
+    mu_run_test(IncrDecr);
+    mu_run_test(SleepUntil);
+    mu_run_test(ToTime);
+}
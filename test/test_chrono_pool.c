@@ -0,0 +1,124 @@
+#define _GNU_SOURCE
+#include "chrono.c"
+#include "chrono_pthread.c"
+#include "chrono_pool.c"
+#include "minunit.h"
+
+static chrono_pool_t pool;
+static _Atomic bool gate;
+static _Atomic int done;
+static int order[8];
+static _Atomic int norder;
+
+static void wait_gate(void * arg)
+{
+    (void)arg;
+    while (!atomic_load(&gate))
+        ChronoSleepForValue(1, chrono_milliseconds);
+    atomic_fetch_add(&done, 1);
+}
+
+static void record(void * arg)
+{
+    order[atomic_fetch_add(&norder, 1)] = (int)(intptr_t)arg;
+    atomic_fetch_add(&done, 1);
+}
+
+static void waitDone(int n)
+{
+    while (atomic_load(&done) < n)
+        ChronoSleepForValue(1, chrono_milliseconds);
+}
+
+mu_test_case(Edf) {
+    chrono_mno_t now, deadline;
+    atomic_store(&gate, false);
+    atomic_store(&done, 0);
+    atomic_store(&norder, 0);
+    mu_assert(ChronoPoolInit(&pool, 1));
+
+    ChronoMnoNow(&now);
+    deadline = now;
+    ChronoMnoAddValue(&deadline, 10, chrono_seconds);
+    ChronoPoolSubmit(&pool, &deadline, wait_gate, NULL);
+    ChronoSleepForValue(5, chrono_milliseconds);
+
+    static int const ms[5] = { 50, 10, 40, 20, 30 };
+    for (int i = 0; i < 5; ++i) {
+        deadline = now;
+        ChronoMnoAddValue(&deadline, 1000 + ms[i], chrono_milliseconds);
+        mu_assert(ChronoPoolSubmit(&pool, &deadline, record, (void *)(intptr_t)ms[i]));
+    }
+    atomic_store(&gate, true);
+    waitDone(6);
+    for (int i = 0; i < 5; ++i)
+        mu_assert(order[i] == (i + 1) * 10);
+    mu_assert(ChronoPoolExecuted(&pool) == 6);
+    mu_assert(ChronoPoolMissed(&pool) == 0);
+    ChronoPoolDestroy(&pool);
+}
+
+mu_test_case(Delayed) {
+    chrono_mno_t start, at, deadline;
+    chrono_t c;
+    atomic_store(&done, 0);
+    atomic_store(&norder, 0);
+    mu_assert(ChronoPoolInit(&pool, 2));
+
+    ChronoMnoNow(&start);
+    at = start;
+    ChronoMnoAddValue(&at, 20, chrono_milliseconds);
+    deadline = at;
+    ChronoMnoAddValue(&deadline, 1, chrono_seconds);
+    mu_assert(ChronoPoolSubmitAt(&pool, &at, &deadline, record, (void *)2));
+    mu_assert(ChronoPoolSubmit(&pool, &deadline, record, (void *)1));
+    waitDone(2);
+    ChronoMnoDiffNow(&start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 20);
+    mu_assert(order[0] == 1 && order[1] == 2);
+
+    // 期限を過ぎたタスク
+    ChronoPoolSubmit(&pool, &start, record, (void *)3);
+    waitDone(3);
+    ChronoSleepForValue(1, chrono_milliseconds);
+    mu_assert(ChronoPoolMissed(&pool) == 1);
+    ChronoPoolDestroy(&pool);
+}
+
+static void nop(void * arg)
+{
+    (void)arg;
+    ChronoSleepForValue(100, chrono_microseconds);
+    atomic_fetch_add(&done, 1);
+}
+
+static void spawner(void * arg)
+{
+    (void)arg;
+    chrono_mno_t deadline;
+    ChronoMnoNow(&deadline);
+    ChronoMnoAddValue(&deadline, 10, chrono_seconds);
+    for (int i = 0; i < 100; ++i)
+        ChronoPoolSubmit(&pool, &deadline, nop, NULL);  // 自分のキューに入る
+    ChronoSleepForValue(20, chrono_milliseconds);
+    atomic_fetch_add(&done, 1);
+}
+
+mu_test_case(Steal) {
+    chrono_mno_t deadline;
+    atomic_store(&done, 0);
+    mu_assert(ChronoPoolInit(&pool, 4));
+    ChronoMnoNow(&deadline);
+    ChronoPoolSubmit(&pool, &deadline, spawner, NULL);
+    waitDone(101);
+    mu_assert(ChronoPoolStolen(&pool) > 0);
+    ChronoPoolDestroy(&pool);
+    mu_assert(ChronoPoolExecuted(&pool) == 101);
+}
+
+int main()
+{
+    mu_run_test(Edf);
+    mu_run_test(Delayed);
+    mu_run_test(Steal);
+}
@@ -0,0 +1,105 @@
+#define _GNU_SOURCE
+#include "chrono.c"
+#include "chrono_prof.c"
+#include "minunit.h"
+#include <pthread.h>
+
+static volatile uint64_t sink;
+
+static void busy(int ms)
+{
+    chrono_cpu_t start;
+    chrono_t c;
+    ChronoCpuNow(&start);
+    do {
+        for (int i = 0; i < 10000; ++i)
+            sink = sink * 31 + i;
+        ChronoCpuDiffNow(&start, &c);
+    } while (ChronoGet(&c, chrono_milliseconds) < ms);
+}
+
+mu_test_case(Thread) {
+    chrono_prof_t prof;
+    chrono_t interval = ChronoInit(1, chrono_milliseconds);
+    mu_assert(ChronoProfInit(&prof, 1024));
+    mu_assert(ChronoProfStart(&prof, chrono_prof_thread, &interval));
+    mu_assert(!ChronoProfStart(&prof, chrono_prof_thread, &interval));
+    busy(100);
+    mu_assert(ChronoProfStop(&prof));
+    mu_assert(!ChronoProfStop(&prof));
+
+    mu_assert(ChronoProfSamples(&prof) >= 10);
+    mu_assert(ChronoProfDropped(&prof) == 0);
+
+    chrono_t c;
+    ChronoProfOverhead(&prof, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) < 10);
+
+    char * buf;
+    size_t len;
+    FILE * fp = open_memstream(&buf, &len);
+    mu_assert(ChronoProfWriteFolded(&prof, fp));
+    fclose(fp);
+    mu_assert(len > 0);
+    mu_assert(buf[len - 1] == '\n');
+    mu_assert(strstr(buf, "__libc_start") != NULL);
+    free(buf);
+    ChronoProfDestroy(&prof);
+}
+
+mu_test_case(Dropped) {
+    chrono_prof_t prof;
+    chrono_t interval = ChronoInit(1, chrono_milliseconds);
+    mu_assert(ChronoProfInit(&prof, 4));
+    mu_assert(ChronoProfStart(&prof, chrono_prof_process, &interval));
+    busy(50);
+    mu_assert(ChronoProfStop(&prof));
+    mu_assert(ChronoProfSamples(&prof) == 4);
+    mu_assert(ChronoProfDropped(&prof) > 0);
+
+    ChronoProfReset(&prof);
+    mu_assert(ChronoProfSamples(&prof) == 0);
+    ChronoProfDestroy(&prof);
+}
+
+static atomic_bool spinning;
+
+static void * spin(void * arg)
+{
+    (void)arg;
+    while (atomic_load(&spinning))
+        sink = sink * 31 + 1;
+    return NULL;
+}
+
+mu_test_case(StopWhileSampling) {
+    // 別スレッドでシグナルを受け続けている間に、停止と解放を繰り返す
+    chrono_t interval = ChronoInit(100, chrono_microseconds);
+    pthread_t th;
+    atomic_store(&spinning, true);
+    mu_assert(pthread_create(&th, NULL, spin, NULL) == 0);
+    bool ok = true;
+    for (int i = 0; i < 50 && ok; ++i) {
+        chrono_prof_t prof;
+        ok &= ChronoProfInit(&prof, 64);
+        ok &= ChronoProfStart(&prof, chrono_prof_process, &interval);
+        busy(2);
+        ok &= ChronoProfStop(&prof);
+
+        // 停止後はサンプルが増えない
+        size_t n = atomic_load(&prof.count);
+        busy(2);
+        ok &= atomic_load(&prof.count) == n;
+        ChronoProfDestroy(&prof);
+    }
+    atomic_store(&spinning, false);
+    pthread_join(th, NULL);
+    mu_assert(ok);
+}
+
+int main()
+{
+    mu_run_test(Thread);
+    mu_run_test(Dropped);
+    mu_run_test(StopWhileSampling);
+}
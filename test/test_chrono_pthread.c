@@ -0,0 +1,110 @@
+#define _GNU_SOURCE
+#include "chrono.c"
+#include "chrono_pthread.c"
+#include "minunit.h"
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond;
+static bool ready;
+static int spurious;
+
+static bool isReady(void * arg)
+{
+    (void)arg;
+    return ready;
+}
+
+static void * notifier(void * arg)
+{
+    (void)arg;
+    // 条件を満たさずに何度か起こしてから、条件を満たす
+    for (int i = 0; i < 3; ++i) {
+        ChronoSleepForValue(2, chrono_milliseconds);
+        pthread_mutex_lock(&mutex);
+        ++spurious;
+        pthread_cond_signal(&cond);
+        pthread_mutex_unlock(&mutex);
+    }
+    pthread_mutex_lock(&mutex);
+    ready = true;
+    pthread_cond_signal(&cond);
+    pthread_mutex_unlock(&mutex);
+    return NULL;
+}
+
+mu_test_case(Cond) {
+    chrono_mno_t start, deadline;
+    chrono_t c, timeout = ChronoInit(10, chrono_milliseconds);
+    mu_assert(ChronoCondInit(&cond));
+
+    pthread_mutex_lock(&mutex);
+    ChronoMnoNow(&start);
+    mu_assert(ChronoCondWaitFor(&cond, &mutex, &timeout) == ETIMEDOUT);
+    ChronoMnoDiffNow(&start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 10);
+
+    // 見せかけの起床があっても、同じ期限で打ち切る
+    ChronoMnoNow(&start);
+    deadline = start;
+    ChronoMnoAddValue(&deadline, 20, chrono_milliseconds);
+    mu_assert(!ChronoCondWaitPred(&cond, &mutex, &deadline, isReady, NULL));
+    ChronoMnoDiffNow(&start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 20 && ChronoGet(&c, chrono_milliseconds) < 100);
+
+    // 不正な期限では待ち続けずに false を返す
+    deadline.time_point.tv_nsec = -1;
+    mu_assert(!ChronoCondWaitPred(&cond, &mutex, &deadline, isReady, NULL));
+    pthread_mutex_unlock(&mutex);
+
+    pthread_t th;
+    pthread_create(&th, NULL, notifier, NULL);
+    pthread_mutex_lock(&mutex);
+    timeout = ChronoInit(1, chrono_seconds);
+    mu_assert(ChronoCondWaitPredFor(&cond, &mutex, &timeout, isReady, NULL));
+    pthread_mutex_unlock(&mutex);
+    pthread_join(th, NULL);
+    mu_assert(spurious == 3);
+    pthread_cond_destroy(&cond);
+}
+
+static void * holder(void * arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&mutex);
+    ChronoSleepForValue(20, chrono_milliseconds);
+    pthread_mutex_unlock(&mutex);
+    return NULL;
+}
+
+mu_test_case(Mutex) {
+    chrono_t timeout = ChronoInit(1, chrono_milliseconds);
+    mu_assert(ChronoMutexLockFor(&mutex, &timeout) == 0);
+    pthread_mutex_unlock(&mutex);
+
+    pthread_t th;
+    pthread_create(&th, NULL, holder, NULL);
+    ChronoSleepForValue(5, chrono_milliseconds);
+    mu_assert(ChronoMutexLockFor(&mutex, &timeout) == ETIMEDOUT);
+    timeout = ChronoInit(1, chrono_seconds);
+    mu_assert(ChronoMutexLockFor(&mutex, &timeout) == 0);
+    pthread_mutex_unlock(&mutex);
+    pthread_join(th, NULL);
+}
+
+mu_test_case(Sem) {
+    sem_t sem;
+    chrono_t timeout = ChronoInit(5, chrono_milliseconds);
+    sem_init(&sem, 0, 1);
+    mu_assert(ChronoPosixSemWaitFor(&sem, &timeout) == 0);
+    mu_assert(ChronoPosixSemWaitFor(&sem, &timeout) == ETIMEDOUT);
+    sem_post(&sem);
+    mu_assert(ChronoPosixSemWait(&sem, NULL) == 0);
+    sem_destroy(&sem);
+}
+
+int main()
+{
+    mu_run_test(Cond);
+    mu_run_test(Mutex);
+    mu_run_test(Sem);
+}
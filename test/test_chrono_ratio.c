@@ -0,0 +1,135 @@
+#include "chrono.c"
+#include "chrono_ratio.c"
+#include "minunit.h"
+#include <stdlib.h>
+
+mu_test_case(Period) {
+    chrono_ratio_t r;
+    chrono_period_t cp;
+    ChronoRatioFromPeriod(chrono_milliseconds, &r);
+    mu_assert(r.num == 1 && r.den == 1000);
+    ChronoRatioFromPeriod(chrono_hours, &r);
+    mu_assert(r.num == 3600 && r.den == 1);
+
+    r = ChronoRatioInit(2, 2000);
+    mu_assert(ChronoRatioToPeriod(&r, &cp));
+    mu_assert(cp == chrono_milliseconds);
+    r = ChronoRatioInit(1, 90000);
+    mu_assert(ChronoRatioToPeriod(&r, &cp));
+    mu_assert(cp == -90000);
+    r = ChronoRatioInit(1001, 30000);
+    mu_assert(!ChronoRatioToPeriod(&r, &cp));
+}
+
+mu_test_case(Get) {
+    chrono_tick_t t = ChronoTickInit(90000, 1, 90000);
+    chrono_ratio_t r = ChronoRatioInit(1, 48000);
+    mu_assert(ChronoTickGet(&t, &r) == 48000);
+
+    r = ChronoRatioInit(1, 1000000000);
+    t = ChronoTickInit(1, 1, 90000);
+    mu_assert(ChronoTickGet(&t, &r) == 11111);
+    t = ChronoTickInit(-1, 1, 90000);
+    mu_assert(ChronoTickGet(&t, &r) == -11111);
+
+    // NTSC 29.97fps
+    t = ChronoTickInit(30000, 1001, 30000);
+    r = ChronoRatioInit(1, 1);
+    mu_assert(ChronoTickGet(&t, &r) == 1001);
+}
+
+mu_test_case(Add) {
+    chrono_tick_t t1 = ChronoTickInit(1, 1, 90000);
+    chrono_tick_t t2 = ChronoTickInit(1, 1, 48000);
+    mu_assert(ChronoTickAdd(&t1, &t2));
+    mu_assert(t1.period.num == 1 && t1.period.den == 720000);
+    mu_assert(t1.value == 8 + 15);
+
+    mu_assert(ChronoTickSub(&t1, &t2));
+    mu_assert(ChronoTickSub(&t1, &t2));
+    chrono_tick_t t3 = ChronoTickInit(1, 1, 90000);
+    mu_assert(ChronoTickAdd(&t1, &t2));
+    mu_assert(ChronoTickComp(&t1, &t3) == 0);
+
+    t1 = ChronoTickInit(INTMAX_MAX, 1, 1);
+    t2 = ChronoTickInit(1, 1, 1);
+    mu_assert(!ChronoTickAdd(&t1, &t2));
+    mu_assert(t1.value == INTMAX_MAX);
+}
+
+mu_test_case(Comp) {
+    chrono_tick_t t1 = ChronoTickInit(3, 1, 90000);
+    chrono_tick_t t2 = ChronoTickInit(2, 1, 48000);
+    mu_assert(ChronoTickComp(&t1, &t2) < 0);
+    mu_assert(ChronoTickComp(&t2, &t1) > 0);
+
+    t1 = ChronoTickInit(90000, 1, 90000);
+    t2 = ChronoTickInit(1, 1, 1);
+    mu_assert(ChronoTickComp(&t1, &t2) == 0);
+}
+
+mu_test_case(Chrono) {
+    chrono_t c = ChronoInit(12, chrono_milliseconds);
+    chrono_tick_t t;
+    ChronoTickFromChrono(&c, &t);
+    chrono_ratio_t r = ChronoRatioInit(1, 90000);
+    mu_assert(ChronoTickGet(&t, &r) == 1080);
+
+    chrono_t c2;
+    mu_assert(ChronoTickToChrono(&t, &c2));
+    mu_assert(c2.value == 12 && c2.period == chrono_milliseconds);
+
+    t = ChronoTickInit(3, 1001, 30000);
+    mu_assert(ChronoTickToChrono(&t, &c2));
+    mu_assert(ChronoGet(&c2, chrono_nanoseconds) == 100100000);
+    t = ChronoTickInit(1, 1001, 30000);
+    mu_assert(!ChronoTickToChrono(&t, &c2));
+    mu_assert(ChronoGet(&c2, chrono_nanoseconds) == 33366666);
+}
+
+mu_test_case(Conv) {
+    chrono_ratio_t from = ChronoRatioInit(1, 90000);
+    chrono_ratio_t to = ChronoRatioInit(1, 48000);
+    chrono_ratio_conv_t rc;
+    mu_assert(ChronoRatioConvInit(&rc, &from, &to));
+    mu_assert(rc.num == 8 && rc.den == 15);
+    mu_assert(ChronoRatioConv(&rc, 90000) == 48000);
+    mu_assert(ChronoRatioConv(&rc, -90000) == -48000);
+    mu_assert(ChronoRatioConv(&rc, 1) == 0);
+
+    // 逆数の乗算と除算の一致
+    chrono_ratio_t rs[] = {
+        ChronoRatioInit(1, 90000), ChronoRatioInit(1, 48000), ChronoRatioInit(1001, 30000),
+        ChronoRatioInit(1, 1000000000), ChronoRatioInit(1, 1), ChronoRatioInit(7, 3),
+        ChronoRatioInit(1, 44100),
+    };
+    int nr = sizeof(rs) / sizeof(rs[0]);
+    srand(1);
+    for (int i = 0; i < nr; ++i) {
+        for (int j = 0; j < nr; ++j) {
+            ChronoRatioConvInit(&rc, &rs[i], &rs[j]);
+            for (int k = 0; k < 1000; ++k) {
+                intmax_t v = ((intmax_t)rand() << 20) ^ rand();
+                if (k & 1)
+                    v = -v;
+                chrono_tick_t t = ChronoTickInit(v, rs[i].num, rs[i].den);
+                mu_assert(ChronoRatioConv(&rc, v) == ChronoTickGet(&t, &rs[j]));
+            }
+        }
+    }
+
+    intmax_t src[3] = { 0, 90000, 180000 }, dst[3];
+    ChronoRatioConvInit(&rc, &from, &to);
+    ChronoRatioConvArray(&rc, src, dst, 3);
+    mu_assert(dst[0] == 0 && dst[1] == 48000 && dst[2] == 96000);
+}
+
+int main()
+{
+    mu_run_test(Period);
+    mu_run_test(Get);
+    mu_run_test(Add);
+    mu_run_test(Comp);
+    mu_run_test(Chrono);
+    mu_run_test(Conv);
+}
@@ -0,0 +1,51 @@
+#include "chrono.c"
+#include "minunit.h"
+
+mu_test_case(MinMax) {
+    chrono_raw_t zero, min, max;
+    ChronoRawZero(&zero);
+    ChronoRawMin(&min);
+    ChronoRawMax(&max);
+    mu_assert(ChronoRawComp(&min, &zero) <= 0);
+    mu_assert(ChronoRawComp(&zero, &max) <= 0);
+    mu_assert(ChronoRawComp(&min,  &max) <  0);
+}
+
+mu_test_case(Now) {
+    chrono_raw_t cr1, cr2;
+    ChronoRawNow(&cr1);
+    ChronoSleepForValue(1, chrono_milliseconds);
+    ChronoRawNow(&cr2);
+    mu_assert(ChronoRawComp(&cr1, &cr2) < 0);
+}
+
+mu_test_case(Elapsed) {
+    // 速度調整を受けないだけで、経過時間はモノトニック時刻とほぼ等しい
+    chrono_mno_t cm;
+    chrono_raw_t cr;
+    chrono_t c1, c2;
+    ChronoMnoNow(&cm);
+    ChronoRawNow(&cr);
+    ChronoSleepForValue(20, chrono_milliseconds);
+    ChronoMnoDiffNow(&cm, &c1);
+    ChronoRawDiffNow(&cr, &c2);
+    mu_assert(llabs(ChronoGet(&c1, chrono_milliseconds) - ChronoGet(&c2, chrono_milliseconds)) <= 1);
+}
+
+mu_test_case(Add) {
+    chrono_raw_t cr1, cr2;
+    ChronoRawNow(&cr1);
+    cr2 = cr1;
+    ChronoRawAddValue(&cr1, 1, chrono_hours);
+    mu_assert(ChronoRawComp(&cr1, &cr2) > 0);
+    ChronoRawAddValue(&cr2, 60, chrono_minutes);
+    mu_assert(ChronoRawComp(&cr1, &cr2) == 0);
+}
+
+int main()
+{
+    mu_run_test(MinMax);
+    mu_run_test(Now);
+    mu_run_test(Elapsed);
+    mu_run_test(Add);
+}
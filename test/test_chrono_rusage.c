@@ -0,0 +1,75 @@
+#define _GNU_SOURCE
+#include "chrono.c"
+#include "chrono_rusage.c"
+#include "minunit.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void busy(intmax_t ms)
+{
+    chrono_cpu_t start;
+    chrono_t c;
+    ChronoCpuNow(&start);
+    do {
+        ChronoCpuDiffNow(&start, &c);
+    } while (ChronoGet(&c, chrono_milliseconds) < ms);
+}
+
+mu_test_case(Now) {
+    chrono_rusage_t ru;
+    mu_assert(ChronoRusageNow(&ru, chrono_rusage_self));
+    mu_assert(ChronoGet(&ru.user, chrono_nanoseconds) >= 0);
+    mu_assert(ru.maxrss > 0);
+    mu_assert(ChronoRusageNow(&ru, chrono_rusage_thread));
+}
+
+mu_test_case(DiffCpu) {
+    chrono_rusage_t ru1, ru2;
+    chrono_rusage_diff_t d;
+    ChronoRusageNow(&ru1, chrono_rusage_thread);
+    busy(50);
+    ChronoRusageNow(&ru2, chrono_rusage_thread);
+    ChronoRusageDiff(&ru1, &ru2, &d);
+
+    mu_assert(ChronoGet(&d.elapsed, chrono_milliseconds) >= 50);
+    mu_assert(ChronoGet(&d.user, chrono_milliseconds) + ChronoGet(&d.system, chrono_milliseconds) > 0);
+    mu_assert(d.user_permille + d.system_permille > 0);
+    mu_assert(d.user_permille + d.system_permille <= 1100);
+}
+
+mu_test_case(DiffSleep) {
+    chrono_rusage_t ru1, ru2;
+    chrono_rusage_diff_t d;
+    ChronoRusageNow(&ru1, chrono_rusage_thread);
+    for (int i = 0; i < 5; ++i)
+        ChronoSleepForValue(1, chrono_milliseconds);
+    ChronoRusageNow(&ru2, chrono_rusage_thread);
+    ChronoRusageDiff(&ru1, &ru2, &d);
+
+    mu_assert(d.nvcsw >= 5);
+    mu_assert(d.nvcsw_rate > 0);
+    mu_assert(d.user_permille + d.system_permille < 500);
+}
+
+mu_test_case(DiffFault) {
+    chrono_rusage_t ru1, ru2;
+    chrono_rusage_diff_t d;
+    size_t size = 16 * 1024 * 1024;
+    ChronoRusageNow(&ru1, chrono_rusage_self);
+    char * p = malloc(size);
+    memset(p, 1, size);
+    ChronoRusageNow(&ru2, chrono_rusage_self);
+    free(p);
+    ChronoRusageDiff(&ru1, &ru2, &d);
+
+    mu_assert(d.minflt > 0);
+    mu_assert(d.minflt_rate > 0);
+}
+
+int main()
+{
+    mu_run_test(Now);
+    mu_run_test(DiffCpu);
+    mu_run_test(DiffSleep);
+    mu_run_test(DiffFault);
+}
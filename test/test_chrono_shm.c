@@ -0,0 +1,89 @@
+#include "chrono.c"
+#include "chrono_tsc.c"
+#include "chrono_shm.c"
+#include "minunit.h"
+#include <stdio.h>
+
+static char name[64];
+
+mu_test_case(Open) {
+    chrono_shm_pub_t sp;
+    chrono_shm_sub_t ss;
+    chrono_t stale = ChronoInit(1, chrono_seconds);
+
+    mu_assert(!ChronoShmSubscriberOpen(&ss, name, &stale));
+    mu_assert(ChronoShmPublisherOpen(&sp, name));
+    mu_assert(ChronoShmSubscriberOpen(&ss, name, &stale));
+
+    // 発行前は古い
+    mu_assert(ChronoShmIsStale(&ss));
+
+    // 2 つ目の発行者は開けない
+    chrono_shm_pub_t other;
+    mu_assert(!ChronoShmPublisherOpen(&other, name));
+    mu_assert(other.page == NULL);
+
+    ChronoShmSubscriberClose(&ss);
+    ChronoShmPublisherClose(&sp);
+    mu_assert(!ChronoShmSubscriberOpen(&ss, name, &stale));
+}
+
+mu_test_case(Now) {
+    chrono_shm_pub_t sp;
+    chrono_shm_sub_t ss;
+    chrono_t stale = ChronoInit(1, chrono_seconds);
+    ChronoShmPublisherOpen(&sp, name);
+    ChronoShmSubscriberOpen(&ss, name, &stale);
+    mu_assert(ChronoShmPublish(&sp));
+
+    chrono_mno_t cm1, cm2;
+    chrono_sys_t cs1, cs2;
+    ChronoMnoNow(&cm1);
+    ChronoSysNow(&cs1);
+    mu_assert(ChronoShmMnoNow(&ss, &cm2));
+    mu_assert(ChronoShmSysNow(&ss, &cs2));
+
+    chrono_t diff;
+    ChronoMnoDiff(&cm1, &cm2, &diff);
+    mu_assert(ChronoGet(&diff, chrono_milliseconds) < 10);
+    ChronoSysDiff(&cs1, &cs2, &diff);
+    mu_assert(ChronoGet(&diff, chrono_milliseconds) < 10);
+
+    if (ChronoTscSupported())
+        mu_assert(!ChronoShmIsStale(&ss));
+
+    ChronoShmSubscriberClose(&ss);
+    ChronoShmPublisherClose(&sp);
+}
+
+mu_test_case(Stale) {
+    chrono_shm_pub_t sp;
+    chrono_shm_sub_t ss;
+    chrono_t stale = ChronoInit(1, chrono_milliseconds);
+    ChronoShmPublisherOpen(&sp, name);
+    ChronoShmSubscriberOpen(&ss, name, &stale);
+    ChronoShmPublish(&sp);
+    ChronoSleepForValue(5, chrono_milliseconds);
+    mu_assert(ChronoShmIsStale(&ss));
+
+    // 古い場合は自プロセスの時計を使う
+    chrono_mno_t cm1, cm2;
+    ChronoShmMnoNow(&ss, &cm2);
+    ChronoMnoNow(&cm1);
+    mu_assert(ChronoMnoComp(&cm2, &cm1) <= 0);
+
+    chrono_t diff;
+    ChronoMnoDiff(&cm1, &cm2, &diff);
+    mu_assert(ChronoGet(&diff, chrono_milliseconds) < 1);
+
+    ChronoShmSubscriberClose(&ss);
+    ChronoShmPublisherClose(&sp);
+}
+
+int main()
+{
+    snprintf(name, sizeof(name), "/chrono_test_%d", (int)getpid());
+    mu_run_test(Open);
+    mu_run_test(Now);
+    mu_run_test(Stale);
+}
@@ -0,0 +1,117 @@
+#include "chrono.c"
+#include "chrono_stat.c"
+#include "minunit.h"
+
+mu_test_case(Empty) {
+    chrono_stat_t st;
+    chrono_t c;
+    ChronoStatInit(&st);
+    mu_assert(ChronoStatCount(&st) == 0);
+    mu_assert(!ChronoStatMin(&st, &c));
+    mu_assert(!ChronoStatMean(&st, &c));
+    mu_assert(!ChronoStatStddev(&st, &c));
+    mu_assert(!ChronoStatQuantile(&st, chrono_stat_p50, &c));
+}
+
+mu_test_case(Few) {
+    chrono_stat_t st;
+    chrono_t c;
+    ChronoStatInit(&st);
+    ChronoStatAddValue(&st, 3, chrono_microseconds);
+    ChronoStatAddValue(&st, 1, chrono_microseconds);
+    ChronoStatAddValue(&st, 2, chrono_microseconds);
+    mu_assert(ChronoStatCount(&st) == 3);
+    ChronoStatMin(&st, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 1000);
+    ChronoStatMax(&st, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 3000);
+    ChronoStatMean(&st, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 2000);
+    ChronoStatStddev(&st, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 1000);
+    ChronoStatQuantile(&st, chrono_stat_p50, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) == 2000);
+}
+
+static int64_t lcg(uint64_t * s)
+{
+    *s = *s * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int64_t)(*s >> 33) % 100000;
+}
+
+mu_test_case(Uniform) {
+    chrono_stat_t st;
+    chrono_t c;
+    uint64_t seed = 1;
+    ChronoStatInit(&st);
+    for (int i = 0; i < 100000; ++i)
+        ChronoStatAddValue(&st, lcg(&seed), chrono_nanoseconds);
+
+    ChronoStatMean(&st, &c);
+    mu_assert(llabs(ChronoGet(&c, chrono_nanoseconds) - 50000) < 1000);
+    ChronoStatQuantile(&st, chrono_stat_p50, &c);
+    mu_assert(llabs(ChronoGet(&c, chrono_nanoseconds) - 50000) < 1000);
+    ChronoStatQuantile(&st, chrono_stat_p90, &c);
+    mu_assert(llabs(ChronoGet(&c, chrono_nanoseconds) - 90000) < 1000);
+    ChronoStatQuantile(&st, chrono_stat_p99, &c);
+    mu_assert(llabs(ChronoGet(&c, chrono_nanoseconds) - 99000) < 1000);
+    ChronoStatStddev(&st, &c);  // 100000 / sqrt(12)
+    mu_assert(llabs(ChronoGet(&c, chrono_nanoseconds) - 28867) < 500);
+}
+
+mu_test_case(Merge) {
+    chrono_stat_t all, part[4];
+    chrono_t c1, c2;
+    uint64_t seed = 7;
+    ChronoStatInit(&all);
+    for (int i = 0; i < 4; ++i)
+        ChronoStatInit(&part[i]);
+    for (int i = 0; i < 40000; ++i) {
+        int64_t x = lcg(&seed);
+        ChronoStatAddValue(&all, x, chrono_nanoseconds);
+        ChronoStatAddValue(&part[i % 4], x, chrono_nanoseconds);
+    }
+    for (int i = 1; i < 4; ++i)
+        ChronoStatMerge(&part[0], &part[i]);
+
+    mu_assert(ChronoStatCount(&part[0]) == 40000);
+    ChronoStatMin(&all, &c1); ChronoStatMin(&part[0], &c2);
+    mu_assert(ChronoGet(&c1, chrono_nanoseconds) == ChronoGet(&c2, chrono_nanoseconds));
+    ChronoStatMax(&all, &c1); ChronoStatMax(&part[0], &c2);
+    mu_assert(ChronoGet(&c1, chrono_nanoseconds) == ChronoGet(&c2, chrono_nanoseconds));
+    ChronoStatMean(&all, &c1); ChronoStatMean(&part[0], &c2);
+    mu_assert(llabs(ChronoGet(&c1, chrono_nanoseconds) - ChronoGet(&c2, chrono_nanoseconds)) <= 1);
+    ChronoStatStddev(&all, &c1); ChronoStatStddev(&part[0], &c2);
+    mu_assert(llabs(ChronoGet(&c1, chrono_nanoseconds) - ChronoGet(&c2, chrono_nanoseconds)) <= 1);
+    ChronoStatQuantile(&part[0], chrono_stat_p90, &c2);
+    mu_assert(llabs(ChronoGet(&c2, chrono_nanoseconds) - 90000) < 2000);
+
+    // 少数の標本は正確に合算される
+    chrono_stat_t few;
+    ChronoStatInit(&few);
+    ChronoStatAddValue(&few, 1, chrono_seconds);
+    ChronoStatMerge(&part[0], &few);
+    ChronoStatMax(&part[0], &c2);
+    mu_assert(ChronoGet(&c2, chrono_seconds) == 1);
+    mu_assert(ChronoStatCount(&part[0]) == 40001);
+}
+
+mu_test_case(Since) {
+    chrono_stat_t st;
+    chrono_mno_t start;
+    chrono_t c;
+    ChronoStatInit(&st);
+    ChronoMnoNow(&start);
+    mu_assert(ChronoStatAddSince(&st, &start));
+    ChronoStatMax(&st, &c);
+    mu_assert(ChronoGet(&c, chrono_nanoseconds) >= 0);
+}
+
+int main()
+{
+    mu_run_test(Empty);
+    mu_run_test(Few);
+    mu_run_test(Uniform);
+    mu_run_test(Merge);
+    mu_run_test(Since);
+}
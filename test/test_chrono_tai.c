@@ -0,0 +1,53 @@
+#include "chrono.c"
+#include "minunit.h"
+
+mu_test_case(MinMax) {
+    chrono_tai_t zero, min, max;
+    ChronoTaiZero(&zero);
+    ChronoTaiMin(&min);
+    ChronoTaiMax(&max);
+    mu_assert(ChronoTaiComp(&min, &zero) <= 0);
+    mu_assert(ChronoTaiComp(&zero, &max) <= 0);
+    mu_assert(ChronoTaiComp(&min,  &max) <  0);
+}
+
+mu_test_case(Sys) {
+    // TAI はシステム時刻より閏秒の分(0秒以上)進んでいる
+    chrono_sys_t cs;
+    chrono_tai_t ct;
+    ChronoSysNow(&cs);
+    ChronoTaiNow(&ct);
+
+    time_t t1, t2;
+    ChronoSysToTimeT(&cs, &t1);
+    ChronoTaiToTimeT(&ct, &t2);
+    mu_assert(t1 <= t2);
+    mu_assert(t2 - t1 < 60);
+}
+
+mu_test_case(Add) {
+    chrono_tai_t ct1, ct2;
+    ChronoTaiNow(&ct1);
+    ct2 = ct1;
+    ChronoTaiAddValue(&ct1, 1, chrono_hours);
+    mu_assert(ChronoTaiComp(&ct1, &ct2) > 0);
+    ChronoTaiAddValue(&ct2, 60, chrono_minutes);
+    mu_assert(ChronoTaiComp(&ct1, &ct2) == 0);
+}
+
+mu_test_case(ToTimeSpec) {
+    chrono_tai_t ct;
+    struct timespec ts;
+    ChronoTaiDHMS(&ct, 1, 0, 0, 5);
+    ChronoTaiToTimeSpec(&ct, &ts);
+    mu_assert(ts.tv_sec == 86405);
+    mu_assert(ts.tv_nsec == 0);
+}
+
+int main()
+{
+    mu_run_test(MinMax);
+    mu_run_test(Sys);
+    mu_run_test(Add);
+    mu_run_test(ToTimeSpec);
+}
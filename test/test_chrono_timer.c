@@ -0,0 +1,102 @@
+#include "chrono.c"
+#include "chrono_timer.c"
+#include "minunit.h"
+
+static int order[16];
+static int norder;
+
+static void record(void * arg)
+{
+    order[norder++] = (int)(intptr_t)arg;
+}
+
+mu_test_case(Coalesce) {
+    chrono_timer_sched_t ts;
+    chrono_mno_t base, cm, wake;
+    chrono_t slack = ChronoInit(10, chrono_milliseconds);
+    mu_assert(ChronoTimerInit(&ts, 8));
+    ChronoMnoZero(&base);
+    norder = 0;
+
+    // 0ms, 5ms, 8ms は 0ms の最遅時刻 10ms でまとめて発火する
+    for (int i = 0; i < 4; ++i) {
+        static int const ms[4] = { 8, 0, 5, 30 };
+        cm = base;
+        ChronoMnoAddValue(&cm, ms[i], chrono_milliseconds);
+        mu_assert(ChronoTimerAdd(&ts, &cm, &slack, record, (void *)(intptr_t)ms[i]) >= 0);
+    }
+    mu_assert(ChronoTimerCount(&ts) == 4);
+    mu_assert(ChronoTimerNext(&ts, &wake));
+    ChronoMnoDiff(&wake, &base, &slack);
+    mu_assert(ChronoGet(&slack, chrono_milliseconds) == 10);
+
+    mu_assert(ChronoTimerExpire(&ts, &wake) == 3);
+    mu_assert(norder == 3 && order[0] == 0 && order[1] == 5 && order[2] == 8);
+    mu_assert(ChronoTimerCount(&ts) == 1);
+    mu_assert(ChronoTimerWakeups(&ts) == 1);
+
+    mu_assert(ChronoTimerNext(&ts, &wake));
+    mu_assert(ChronoTimerExpire(&ts, &wake) == 1);
+    mu_assert(order[3] == 30);
+    mu_assert(!ChronoTimerNext(&ts, &wake));
+    mu_assert(ChronoTimerWakeups(&ts) == 2);
+    mu_assert(ChronoTimerFired(&ts) == 4);
+    ChronoTimerDestroy(&ts);
+}
+
+mu_test_case(Cancel) {
+    chrono_timer_sched_t ts;
+    chrono_mno_t cm;
+    chrono_t slack = ChronoInit(0, chrono_seconds);
+    int32_t id[4];
+    mu_assert(ChronoTimerInit(&ts, 4));
+    ChronoMnoZero(&cm);
+    norder = 0;
+    for (int i = 0; i < 4; ++i) {
+        ChronoMnoAddValue(&cm, 1, chrono_seconds);
+        id[i] = ChronoTimerAdd(&ts, &cm, &slack, record, (void *)(intptr_t)i);
+        mu_assert(id[i] >= 0);
+    }
+    mu_assert(ChronoTimerAdd(&ts, &cm, &slack, record, NULL) == -1);
+    mu_assert(ChronoTimerCancel(&ts, id[1]));
+    mu_assert(!ChronoTimerCancel(&ts, id[1]));
+    mu_assert(ChronoTimerCancel(&ts, id[3]));
+    mu_assert(ChronoTimerExpire(&ts, &cm) == 2);
+    mu_assert(norder == 2 && order[0] == 0 && order[1] == 2);
+
+    // 発火済みの識別子で、番号を再利用した別のタイマーを取り消さない
+    int32_t reused = ChronoTimerAdd(&ts, &cm, &slack, record, (void *)(intptr_t)4);
+    mu_assert(reused >= 0 && reused != id[2]);
+    mu_assert(!ChronoTimerCancel(&ts, id[2]));
+    mu_assert(!ChronoTimerCancel(&ts, id[0]));
+    mu_assert(ChronoTimerCount(&ts) == 1);
+    mu_assert(ChronoTimerCancel(&ts, reused));
+    ChronoTimerDestroy(&ts);
+}
+
+mu_test_case(Wait) {
+    chrono_timer_sched_t ts;
+    chrono_mno_t start, cm;
+    chrono_t slack = ChronoInit(5, chrono_milliseconds);
+    chrono_t c;
+    mu_assert(ChronoTimerInit(&ts, 4));
+    norder = 0;
+    ChronoMnoNow(&start);
+    cm = start;
+    ChronoMnoAddValue(&cm, 10, chrono_milliseconds);
+    ChronoTimerAdd(&ts, &cm, &slack, record, (void *)1);
+    ChronoMnoAddValue(&cm, 3, chrono_milliseconds);
+    ChronoTimerAdd(&ts, &cm, &slack, record, (void *)2);
+    mu_assert(ChronoTimerWait(&ts) == 2);
+    ChronoMnoDiffNow(&start, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 13);
+    mu_assert(ChronoTimerWait(&ts) == 0);
+    ChronoTimerDestroy(&ts);
+}
+
+int main()
+{
+    mu_run_test(Coalesce);
+    mu_run_test(Cancel);
+    mu_run_test(Wait);
+}
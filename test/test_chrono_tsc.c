@@ -0,0 +1,59 @@
+#include "chrono.c"
+#include "chrono_tsc.c"
+#include "minunit.h"
+
+mu_test_case(Calibrate) {
+    chrono_tsc_t ct;
+    if (!ChronoTscSupported())
+        return;
+    chrono_t c = ChronoInit(1, chrono_milliseconds);
+    mu_assert(ChronoTscCalibrate(&ct, &c));
+    mu_assert(ct.mult > 0);
+}
+
+mu_test_case(Now) {
+    chrono_tsc_t ct;
+    if (!ChronoTscCalibrate(&ct, NULL))
+        return;
+
+    chrono_mno_t cm1, cm2;
+    ChronoMnoNow(&cm1);
+    ChronoTscNow(&ct, &cm2);
+
+    chrono_t diff;
+    ChronoMnoDiff(&cm1, &cm2, &diff);
+    mu_assert(ChronoGet(&diff, chrono_microseconds) < 1000);
+}
+
+mu_test_case(ToChrono) {
+    chrono_tsc_t ct;
+    if (!ChronoTscCalibrate(&ct, NULL))
+        return;
+
+    uint64_t t1 = ChronoTscRead();
+    ChronoSleepForValue(10, chrono_milliseconds);
+    uint64_t t2 = ChronoTscRead();
+
+    chrono_t c;
+    ChronoTscToChrono(&ct, t2 - t1, &c);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) >= 10);
+    mu_assert(ChronoGet(&c, chrono_milliseconds) < 100);
+}
+
+mu_test_case(ToMno) {
+    // 基準より前の TSC は負の時刻になり、ナノ秒の位は [0, 1秒) に正規化される
+    chrono_tsc_t ct = { 2000000000, 0, 1, 0 };
+    chrono_mno_t cm;
+    ChronoTscToMno(&ct, 500000000, &cm);
+    mu_assert(cm.time_point.tv_sec == -2 && cm.time_point.tv_nsec == 500000000);
+    ChronoTscToMno(&ct, 3500000000, &cm);
+    mu_assert(cm.time_point.tv_sec == 1 && cm.time_point.tv_nsec == 500000000);
+}
+
+int main()
+{
+    mu_run_test(Calibrate);
+    mu_run_test(Now);
+    mu_run_test(ToChrono);
+    mu_run_test(ToMno);
+}
@@ -0,0 +1,112 @@
+#include "chrono.c"
+#include "chrono_uid.c"
+#include "minunit.h"
+#include <pthread.h>
+
+#define THREADS 4
+#define IDS 50000
+
+mu_test_case(Init) {
+    chrono_uid_t uid;
+    mu_assert(!ChronoUidInit(&uid, NULL, NULL, 40, 23, 0, 1));
+    mu_assert(!ChronoUidInit(&uid, NULL, NULL, -1, 12, 0, 1));
+    mu_assert(!ChronoUidInit(&uid, NULL, NULL, 10, 12, 1024, 1));
+    mu_assert(ChronoUidInit(&uid, NULL, NULL, 10, 12, 1023, 1));
+    mu_assert(ChronoUidInit(&uid, NULL, NULL, 0, 0, 0, 1));
+    // 予約する連番は 1 単位の連番の数まで
+    mu_assert(ChronoUidInit(&uid, NULL, NULL, 10, 4, 0, 16));
+    mu_assert(!ChronoUidInit(&uid, NULL, NULL, 10, 4, 0, 17));
+    mu_assert(!ChronoUidInit(&uid, NULL, NULL, 0, 0, 0, 2));
+}
+
+mu_test_case(Decode) {
+    chrono_uid_t uid;
+    chrono_sys_t cs1, cs2;
+    chrono_t c;
+    uint64_t worker, sequence;
+    mu_assert(ChronoUidInit(&uid, NULL, NULL, CHRONO_UID_WORKER_BITS, CHRONO_UID_SEQUENCE_BITS, 517, 1));
+
+    ChronoSysNow(&cs1);
+    uint64_t id1 = ChronoUidNext(&uid);
+    uint64_t id2 = ChronoUidNext(&uid);
+    mu_assert(id1 < id2 && (int64_t)id2 > 0);
+    ChronoUidDecode(&uid, id1, &cs2, &worker, &sequence);
+    mu_assert(worker == 517);
+    ChronoSysDiff(&cs2, &cs1, &c);
+    mu_assert(llabs(ChronoGet(&c, chrono_milliseconds)) <= 1);
+
+    // マイクロ秒単位, 任意の epoch
+    chrono_t unit = ChronoInit(1, chrono_microseconds);
+    mu_assert(ChronoUidInit(&uid, &cs1, &unit, 8, 8, 3, 1));
+    ChronoUidDecode(&uid, ChronoUidNext(&uid), &cs2, &worker, NULL);
+    ChronoSysDiff(&cs2, &cs1, &c);
+    mu_assert(worker == 3 && ChronoGet(&c, chrono_milliseconds) < 100);
+}
+
+mu_test_case(Backward) {
+    chrono_uid_t uid;
+    uint64_t sequence;
+    mu_assert(ChronoUidInit(&uid, NULL, NULL, 10, 4, 1, 1));
+
+    // 1 時間先の時刻を発行済みにして、時計の逆行を再現する
+    uint64_t future = ChronoUidNext(&uid) + ((uint64_t)3600000 << 14);
+    atomic_store(&uid.last, (future >> 14 << 4) | 14);
+    uint64_t id1 = ChronoUidNext(&uid);
+    mu_assert(id1 > future);
+    ChronoUidDecode(&uid, id1, NULL, NULL, &sequence);
+    mu_assert(sequence == 15);
+
+    // 連番があふれると時刻が 1 つ進む
+    uint64_t id2 = ChronoUidNext(&uid);
+    ChronoUidDecode(&uid, id2, NULL, NULL, &sequence);
+    mu_assert(sequence == 0 && (id2 >> 14) == (id1 >> 14) + 1);
+}
+
+static chrono_uid_t shared;
+static uint64_t ids[THREADS][IDS];
+
+static void * worker(void * arg)
+{
+    uint64_t * out = arg;
+    for (int i = 0; i < IDS; ++i)
+        out[i] = ChronoUidNext(&shared);
+    return NULL;
+}
+
+static int compare(void const * a, void const * b)
+{
+    uint64_t x = *(uint64_t const *)a, y = *(uint64_t const *)b;
+    return (x > y) - (x < y);
+}
+
+static bool unique(uint64_t block)
+{
+    pthread_t th[THREADS];
+    bool ok = ChronoUidInit(&shared, NULL, NULL, CHRONO_UID_WORKER_BITS, CHRONO_UID_SEQUENCE_BITS, 1, block);
+    for (int i = 0; i < THREADS; ++i)
+        pthread_create(&th[i], NULL, worker, ids[i]);
+    for (int i = 0; i < THREADS; ++i)
+        pthread_join(th[i], NULL);
+
+    for (int i = 0; i < THREADS; ++i)
+        for (int j = 1; j < IDS; ++j)
+            ok &= ids[i][j - 1] < ids[i][j];
+    qsort(ids, THREADS * IDS, sizeof(uint64_t), compare);
+    uint64_t * all = &ids[0][0];
+    for (int i = 1; i < THREADS * IDS; ++i)
+        ok &= all[i - 1] != all[i];
+    return ok;
+}
+
+mu_test_case(Threads) {
+    mu_assert(unique(1));
+    mu_assert(unique(64));
+}
+
+int main()
+{
+    mu_run_test(Init);
+    mu_run_test(Decode);
+    mu_run_test(Backward);
+    mu_run_test(Threads);
+}
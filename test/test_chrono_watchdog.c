@@ -0,0 +1,137 @@
+#include "chrono.c"
+#include "chrono_watchdog.c"
+#include "minunit.h"
+#include <stddef.h>
+
+static chrono_watchdog_t wd;
+static _Atomic int reported[3];
+static _Atomic bool done;
+
+static void callback(void * arg, chrono_watchdog_slot_t const * slot, chrono_watchdog_state_t state,
+                     chrono_t const * wall, chrono_t const * cpu)
+{
+    (void)arg;
+    (void)wall;
+    (void)cpu;
+    int id = slot->name[0] - '0';
+    if (state != chrono_watchdog_ok)
+        atomic_store(&reported[id], state);
+}
+
+static void * beating(void * arg)
+{
+    (void)arg;
+    chrono_watchdog_slot_t * slot = ChronoWatchdogRegister(&wd, "0 beating");
+    while (!atomic_load(&done)) {
+        ChronoWatchdogBeat(slot);
+        ChronoSleepForValue(1, chrono_milliseconds);
+    }
+    ChronoWatchdogUnregister(slot);
+    return NULL;
+}
+
+static void * stalled(void * arg)
+{
+    (void)arg;
+    chrono_watchdog_slot_t * slot = ChronoWatchdogRegister(&wd, "1 stalled");
+    ChronoWatchdogBeat(slot);
+    while (!atomic_load(&done))
+        ChronoSleepForValue(5, chrono_milliseconds);
+    ChronoWatchdogUnregister(slot);
+    return NULL;
+}
+
+static void * spinning(void * arg)
+{
+    (void)arg;
+    chrono_watchdog_slot_t * slot = ChronoWatchdogRegister(&wd, "2 spinning");
+    ChronoWatchdogBeat(slot);
+    while (!atomic_load(&done))
+        ;
+    ChronoWatchdogUnregister(slot);
+    return NULL;
+}
+
+mu_test_case(Classify) {
+    chrono_t interval = ChronoInit(5, chrono_milliseconds);
+    chrono_t timeout = ChronoInit(50, chrono_milliseconds);
+    chrono_t busy = ChronoInit(20, chrono_milliseconds);
+    mu_assert(ChronoWatchdogStart(&wd, &interval, &timeout, &busy, callback, NULL));
+
+    pthread_t th[3];
+    pthread_create(&th[0], NULL, beating, NULL);
+    pthread_create(&th[1], NULL, stalled, NULL);
+    pthread_create(&th[2], NULL, spinning, NULL);
+    ChronoSleepForValue(300, chrono_milliseconds);
+    atomic_store(&done, true);
+    for (int i = 0; i < 3; ++i)
+        pthread_join(th[i], NULL);
+    ChronoWatchdogStop(&wd);
+
+    mu_assert(atomic_load(&reported[0]) == chrono_watchdog_ok);
+    mu_assert(atomic_load(&reported[1]) == chrono_watchdog_stalled);
+    mu_assert(atomic_load(&reported[2]) == chrono_watchdog_spinning);
+}
+
+mu_test_case(Register) {
+    chrono_t interval = ChronoInit(1, chrono_seconds);
+    mu_assert(ChronoWatchdogStart(&wd, &interval, &interval, &interval, NULL, NULL));
+    chrono_watchdog_slot_t * slots[CHRONO_WATCHDOG_THREADS];
+    for (int i = 0; i < CHRONO_WATCHDOG_THREADS; ++i)
+        mu_assert((slots[i] = ChronoWatchdogRegister(&wd, "x")) != NULL);
+    mu_assert(ChronoWatchdogRegister(&wd, "x") == NULL);
+    ChronoWatchdogUnregister(slots[3]);
+    mu_assert(ChronoWatchdogRegister(&wd, "x") == slots[3]);
+    mu_assert(ChronoWatchdogState(slots[0]) == chrono_watchdog_ok);
+    ChronoWatchdogStop(&wd);
+    ChronoWatchdogStop(&wd);
+}
+
+static _Atomic bool reentered;
+
+static void reenter(void * arg, chrono_watchdog_slot_t const * slot, chrono_watchdog_state_t state,
+                    chrono_t const * wall, chrono_t const * cpu)
+{
+    (void)arg;
+    (void)slot;
+    (void)wall;
+    (void)cpu;
+    // ロックを外して呼び出されるので、コールバックから登録や解除ができる
+    if (state != chrono_watchdog_ok) {
+        chrono_watchdog_slot_t * s = ChronoWatchdogRegister(&wd, "x");
+        if (s) {
+            ChronoWatchdogUnregister(s);
+            atomic_store(&reentered, true);
+        }
+    }
+}
+
+mu_test_case(Reenter) {
+    chrono_t interval = ChronoInit(5, chrono_milliseconds);
+    chrono_t timeout = ChronoInit(20, chrono_milliseconds);
+    chrono_t busy = ChronoInit(1, chrono_seconds);
+    atomic_store(&done, false);
+    mu_assert(ChronoWatchdogStart(&wd, &interval, &timeout, &busy, reenter, NULL));
+
+    pthread_t th;
+    pthread_create(&th, NULL, stalled, NULL);
+    for (int i = 0; i < 100 && !atomic_load(&reentered); ++i)
+        ChronoSleepForValue(5, chrono_milliseconds);
+    atomic_store(&done, true);
+    pthread_join(th, NULL);
+    ChronoWatchdogStop(&wd);
+    mu_assert(atomic_load(&reentered));
+}
+
+mu_test_case(Padding) {
+    mu_assert(sizeof(chrono_watchdog_slot_t) % CHRONO_WATCHDOG_CACHE_LINE == 0);
+    mu_assert(offsetof(chrono_watchdog_slot_t, used) - offsetof(chrono_watchdog_slot_t, beat) >= CHRONO_WATCHDOG_CACHE_LINE);
+}
+
+int main()
+{
+    mu_run_test(Classify);
+    mu_run_test(Register);
+    mu_run_test(Reenter);
+    mu_run_test(Padding);
+}
@@ -0,0 +1,120 @@
+#include "chrono.c"
+#include "chrono_window.c"
+#include "minunit.h"
+
+static chrono_window_result_t results[64];
+static int nresults;
+
+static void collect(void * arg, chrono_window_result_t const * r)
+{
+    (void)arg;
+    results[nresults++] = *r;
+}
+
+static void push(chrono_window_t * w, int64_t ms, int64_t value)
+{
+    chrono_sys_pack_t p = { ms * 1000000 };
+    ChronoWindowAddPack(w, &p, value);
+}
+
+static int64_t startMs(chrono_window_result_t const * r)
+{
+    chrono_sys_pack_t p;
+    ChronoSysPack(&r->start, &p);
+    return p.value / 1000000;
+}
+
+mu_test_case(Tumbling) {
+    chrono_window_t w;
+    chrono_t window = ChronoInit(100, chrono_milliseconds);
+    mu_assert(ChronoWindowInit(&w, &window, NULL, NULL, collect, NULL));
+    nresults = 0;
+
+    push(&w, 1005, 1);
+    push(&w, 1050, 2);
+    push(&w, 1099, 3);
+    mu_assert(nresults == 0);
+    push(&w, 1100, 4);   // 1000-1100 が確定する
+    mu_assert(nresults == 1);
+    mu_assert(startMs(&results[0]) == 1000);
+    mu_assert(results[0].count == 3 && results[0].sum == 6);
+    mu_assert(results[0].min == 1 && results[0].max == 3);
+
+    push(&w, 1550, 5);   // 空のウィンドウは出力しない
+    mu_assert(nresults == 2);
+    mu_assert(startMs(&results[1]) == 1100 && results[1].count == 1);
+
+    mu_assert(!ChronoWindowAdd(&w, &results[0].start, 0));
+    mu_assert(ChronoWindowLate(&w) == 1);
+
+    ChronoWindowFlush(&w);
+    mu_assert(nresults == 3);
+    mu_assert(startMs(&results[2]) == 1500 && results[2].sum == 5);
+    ChronoWindowDestroy(&w);
+}
+
+mu_test_case(Sliding) {
+    chrono_window_t w;
+    chrono_t window = ChronoInit(30, chrono_milliseconds);
+    chrono_t slide = ChronoInit(20, chrono_milliseconds);
+    chrono_t lateness = ChronoInit(15, chrono_milliseconds);
+    mu_assert(ChronoWindowInit(&w, &window, &slide, &lateness, collect, NULL));
+    nresults = 0;
+
+    // 許容遅延内の順不同なイベント
+    push(&w, 25, 1);
+    push(&w, 12, 1);
+    push(&w, 45, 1);
+    push(&w, 31, 1);
+    push(&w, 60, 1);
+    ChronoWindowFlush(&w);
+    mu_assert(ChronoWindowLate(&w) == 0);
+
+    // ウィンドウ: [0,30) [20,50) [40,70) [60,90)
+    mu_assert(nresults == 4);
+    mu_assert(startMs(&results[0]) == 0 && results[0].count == 2);
+    mu_assert(startMs(&results[1]) == 20 && results[1].count == 3);
+    mu_assert(startMs(&results[2]) == 40 && results[2].count == 2);
+    mu_assert(startMs(&results[3]) == 60 && results[3].count == 1);
+    ChronoWindowDestroy(&w);
+}
+
+mu_test_case(Negative) {
+    chrono_window_t w;
+    chrono_t window = ChronoInit(10, chrono_milliseconds);
+    mu_assert(ChronoWindowInit(&w, &window, NULL, NULL, collect, NULL));
+    nresults = 0;
+    push(&w, -15, 1);
+    push(&w, -1, 1);
+    ChronoWindowFlush(&w);
+    mu_assert(nresults == 2);
+    mu_assert(startMs(&results[0]) == -20);
+    mu_assert(startMs(&results[1]) == -10);
+    ChronoWindowDestroy(&w);
+}
+
+mu_test_case(Quantile) {
+    chrono_window_t w;
+    chrono_t window = ChronoInit(1, chrono_seconds);
+    mu_assert(ChronoWindowInit(&w, &window, NULL, NULL, collect, NULL));
+    nresults = 0;
+    for (int i = 1; i <= 10000; ++i)
+        push(&w, 0, i * 100);
+    ChronoWindowFlush(&w);
+    mu_assert(nresults == 1);
+    int64_t p50 = ChronoWindowQuantile(&results[0], 0.50);
+    int64_t p99 = ChronoWindowQuantile(&results[0], 0.99);
+    mu_assert(llabs(p50 - 500000) <= 500000 / 16);
+    mu_assert(llabs(p99 - 990000) <= 990000 / 16);
+    mu_assert(ChronoWindowQuantile(&results[0], 1.0) <= 1000000);
+    mu_assert(ChronoWindowQuantile(&results[0], 0.0) == 100);
+    ChronoWindowDestroy(&w);
+}
+
+int main()
+{
+    mu_run_test(Tumbling);
+    mu_run_test(Sliding);
+    mu_run_test(Negative);
+    mu_run_test(Quantile);
+}